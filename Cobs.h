@@ -0,0 +1,77 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_COBS_H
+#define SORO_COBS_H
+
+/** Consistent Overhead Byte Stuffing
+ *
+ * Encoding removes every zero byte from a block, at the cost of one extra
+ * byte per 254, so a zero can mark where each encoded block ends. A reader
+ * finds the blocks in a stream by looking for zeros, without parsing them.
+ */
+namespace Cobs {
+
+    /** Largest possible encoded size of a block, without the terminating zero */
+    inline int maxEncodedSize(int length) {
+        return length + length / 254 + 1;
+    }
+
+    /** Encode a block, not adding the terminating zero
+     *
+     * @param out Holds at least maxEncodedSize(length) bytes
+     * @returns The encoded length
+     */
+    inline int encode(const char* in, int length, char* out) {
+        int code = 0;       // where the current run's length goes
+        int end = 1;
+        for (int i = 0; i < length; i++) {
+            if (in[i] != 0) {
+                out[end++] = in[i];
+            }
+            if ((in[i] == 0) || (end - code == 0xFF)) {
+                out[code] = (char)(end - code);
+                code = end++;
+            }
+        }
+        out[code] = (char)(end - code);
+        return end;
+    }
+
+    /** Decode a block, not including its terminating zero
+     *
+     * @param out Holds at least length bytes
+     * @returns The decoded length, or -1 if the block is malformed
+     */
+    inline int decode(const char* in, int length, char* out) {
+        int end = 0;
+        int i = 0;
+        while (i < length) {
+            int code = (unsigned char)in[i++];
+            if ((code == 0) || (i + code - 1 > length)) return -1;
+            for (int j = 1; j < code; j++) {
+                out[end++] = in[i++];
+            }
+            if ((code != 0xFF) && (i < length)) {
+                out[end++] = 0;
+            }
+        }
+        return end;
+    }
+}
+
+#endif
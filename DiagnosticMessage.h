@@ -0,0 +1,130 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_DIAGNOSTICMESSAGE_H
+#define SORO_DIAGNOSTICMESSAGE_H
+
+#include "Histogram.h"
+#include "LatencyTrace.h"
+#include "JitterBuffer.h"
+
+/* Message types for diagnostics. They are kept clear of the MbedMessageType
+ * values in the soro repository, which only go up from 0.
+ */
+#define MBED_MESSAGE_TIMING_REQUEST 0xF0
+#define MBED_MESSAGE_TIMING_REPORT 0xF1
+#define MBED_MESSAGE_LATENCY_REQUEST 0xF2
+#define MBED_MESSAGE_LATENCY_REPORT 0xF3
+#define MBED_MESSAGE_ECHO 0xF4
+#define MBED_MESSAGE_JITTER_REQUEST 0xF5
+#define MBED_MESSAGE_JITTER_REPORT 0xF6
+
+/** Packing of diagnostic messages. Values are little endian.
+ *
+ * A timing report is the type byte, the overrun count (uint32), then the
+ * release jitter and execution time histograms. Each histogram is its
+ * count, min, max and mean (uint32), its bucket width (uint16) and its
+ * HISTOGRAM_BUCKETS bucket counts (uint16).
+ *
+ * A latency report is the type byte, the lost and traced message counts
+ * (uint32), the last sequence number (uint16) and sender timestamp (uint32),
+ * then the receive to actuate histogram.
+ *
+ * A jitter report is the type byte, the late, dropped and reordered command
+ * counts, the current and maximum playout depth in us, then the number of
+ * sender clock restarts (all uint32).
+ *
+ * An echo is sent back exactly as it arrived, so the sender can put
+ * whatever it needs to time the round trip in it.
+ */
+namespace DiagnosticMessage {
+
+    const int RequiredSize_Histogram = 4 * 4 + 2 + HISTOGRAM_BUCKETS * 2;
+    const int RequiredSize_TimingReport = 1 + 4 + 2 * RequiredSize_Histogram;
+    const int RequiredSize_LatencyReport = 1 + 4 + 4 + 2 + 4 + RequiredSize_Histogram;
+    const int RequiredSize_JitterReport = 1 + 6 * 4;
+
+    inline char* put16(char* message, unsigned short value) {
+        message[0] = value & 0xFF;
+        message[1] = value >> 8;
+        return message + 2;
+    }
+
+    inline char* put32(char* message, unsigned int value) {
+        message = put16(message, value & 0xFFFF);
+        return put16(message, value >> 16);
+    }
+
+    inline char* putHistogram(char* message, const Histogram& histogram) {
+        message = put32(message, histogram.count());
+        message = put32(message, histogram.min());
+        message = put32(message, histogram.max());
+        message = put32(message, histogram.mean());
+        message = put16(message, histogram.bucketWidth());
+        for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            message = put16(message, histogram.bucket(i));
+        }
+        return message;
+    }
+
+    /** Pack a timing report, message must hold RequiredSize_TimingReport bytes
+     *
+     * @returns The length of the message
+     */
+    inline int setTimingReport(char* message, unsigned int overruns,
+            const Histogram& jitter, const Histogram& execution) {
+        char* end = message;
+        *end++ = (char)MBED_MESSAGE_TIMING_REPORT;
+        end = put32(end, overruns);
+        end = putHistogram(end, jitter);
+        end = putHistogram(end, execution);
+        return end - message;
+    }
+
+    /** Pack a latency report, message must hold RequiredSize_LatencyReport bytes
+     *
+     * @returns The length of the message
+     */
+    inline int setLatencyReport(char* message, const LatencyTrace& trace) {
+        char* end = message;
+        *end++ = (char)MBED_MESSAGE_LATENCY_REPORT;
+        end = put32(end, trace.lost());
+        end = put32(end, trace.traced());
+        end = put16(end, trace.sequence());
+        end = put32(end, trace.timestamp());
+        end = putHistogram(end, trace.latency());
+        return end - message;
+    }
+
+    /** Pack a jitter report, message must hold RequiredSize_JitterReport bytes
+     *
+     * @returns The length of the message
+     */
+    inline int setJitterReport(char* message, const JitterBuffer& jitter) {
+        char* end = message;
+        *end++ = (char)MBED_MESSAGE_JITTER_REPORT;
+        end = put32(end, jitter.late());
+        end = put32(end, jitter.dropped());
+        end = put32(end, jitter.reordered());
+        end = put32(end, jitter.depth());
+        end = put32(end, jitter.maxDepth());
+        end = put32(end, jitter.resyncs());
+        return end - message;
+    }
+}
+
+#endif
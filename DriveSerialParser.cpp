@@ -0,0 +1,73 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "DriveSerialParser.h"
+
+#include <cstring>
+
+DriveSerialParser::DriveSerialParser(Serial& serial) : _serial(serial) {
+    _index = 0;
+    _ready = false;
+    _badFrames = 0;
+    _serial.attach(this, &DriveSerialParser::onReceive, Serial::RxIrq);
+}
+
+bool DriveSerialParser::read(char* buffer) {
+    // The frame is only a few bytes, so briefly masking the UART
+    // interrupt is cheaper than double buffering it
+    __disable_irq();
+    bool ready = _ready;
+    if (ready) {
+        memcpy(buffer, _latest, DRIVE_SERIAL_FRAME_SIZE);
+        _ready = false;
+    }
+    __enable_irq();
+    return ready;
+}
+
+void DriveSerialParser::onReceive() {
+    while (_serial.readable()) {
+        decode((unsigned char)_serial.getc());
+    }
+}
+
+void DriveSerialParser::decode(unsigned char c) {
+    if (c == DRIVE_SERIAL_SYNC) {
+        if (_index != 0) {
+            // Lost part of the last frame, start over from this sync byte
+            _badFrames++;
+        }
+        _frame[0] = (char)c;
+        _index = 1;
+        return;
+    }
+    if (_index == 0) {
+        // Not in a frame, wait for the next sync byte
+        return;
+    }
+    if (c > DRIVE_SERIAL_MAX_VALUE) {
+        _badFrames++;
+        _index = 0;
+        return;
+    }
+    _frame[_index++] = (char)c;
+    if (_index == DRIVE_SERIAL_FRAME_SIZE) {
+        memcpy(_latest, _frame, DRIVE_SERIAL_FRAME_SIZE);
+        _ready = true;
+        _index = 0;
+    }
+}
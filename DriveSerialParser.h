@@ -0,0 +1,73 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_DRIVESERIALPARSER_H
+#define SORO_DRIVESERIALPARSER_H
+
+#include "mbed.h"
+
+// Every drive command on the serial port starts with this byte
+#define DRIVE_SERIAL_SYNC 255
+
+// Sync byte followed by the four wheel values, the same layout setDrive() reads
+#define DRIVE_SERIAL_FRAME_SIZE 5
+
+// Wheel values run 0-200 with 100 as stop
+#define DRIVE_SERIAL_MAX_VALUE 200
+
+/** Incremental decoder for the 0xFF framed serial drive protocol
+ *
+ * Bytes are decoded one at a time in the UART RX interrupt, so a half
+ * received frame never blocks the main loop. A sync byte in the middle of
+ * a frame restarts decoding from that byte, and a frame with an out of
+ * range wheel value is thrown away; either way the decoder resyncs on the
+ * next sync byte. Only complete frames are handed out by read().
+ */
+class DriveSerialParser {
+
+public:
+    /** Attach to the RX interrupt of the drive serial port
+     *
+     * @param serial Serial port the drive commands arrive on
+     */
+    DriveSerialParser(Serial& serial);
+
+    /** Get the newest complete frame, if one arrived since the last call
+     *
+     * @param buffer Receives DRIVE_SERIAL_FRAME_SIZE bytes, ready for setDrive()
+     * @returns true if a new frame was copied into buffer
+     */
+    bool read(char* buffer);
+
+    /** Number of frames dropped because they were malformed */
+    inline unsigned int badFrames() {
+        return _badFrames;
+    }
+
+protected:
+    void onReceive();
+    void decode(unsigned char c);
+
+    Serial& _serial;
+    char _frame[DRIVE_SERIAL_FRAME_SIZE];
+    int _index;
+    char _latest[DRIVE_SERIAL_FRAME_SIZE];
+    volatile bool _ready;
+    volatile unsigned int _badFrames;
+};
+
+#endif
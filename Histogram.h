@@ -0,0 +1,94 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_HISTOGRAM_H
+#define SORO_HISTOGRAM_H
+
+#define HISTOGRAM_BUCKETS 16
+
+/** Fixed size histogram of unsigned values, with min, max and mean
+ *
+ * Bucket i counts values from i * bucketWidth up to (i + 1) * bucketWidth,
+ * and the last bucket also counts everything above that. Bucket counts
+ * saturate instead of wrapping.
+ */
+class Histogram {
+
+public:
+    /** Create an empty histogram
+     *
+     * @param bucketWidth Range of values counted by each bucket
+     */
+    Histogram(unsigned int bucketWidth) : _bucketWidth(bucketWidth) {
+        reset();
+    }
+
+    void add(unsigned int value) {
+        unsigned int bucket = value / _bucketWidth;
+        if (bucket >= HISTOGRAM_BUCKETS) bucket = HISTOGRAM_BUCKETS - 1;
+        if (_buckets[bucket] != 0xFFFF) _buckets[bucket]++;
+        if (value < _min) _min = value;
+        if (value > _max) _max = value;
+        _sum += value;
+        _count++;
+    }
+
+    void reset() {
+        for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            _buckets[i] = 0;
+        }
+        _min = 0xFFFFFFFF;
+        _max = 0;
+        _sum = 0;
+        _count = 0;
+    }
+
+    /** Smallest value added, or 0 if there were none */
+    unsigned int min() const {
+        return _count ? _min : 0;
+    }
+
+    unsigned int max() const {
+        return _max;
+    }
+
+    unsigned int mean() const {
+        return _count ? (unsigned int)(_sum / _count) : 0;
+    }
+
+    unsigned int count() const {
+        return _count;
+    }
+
+    unsigned short bucket(int index) const {
+        return _buckets[index];
+    }
+
+    unsigned int bucketWidth() const {
+        return _bucketWidth;
+    }
+
+private:
+    unsigned int _bucketWidth;
+    unsigned short _buckets[HISTOGRAM_BUCKETS];
+    unsigned int _min;
+    unsigned int _max;
+    unsigned long long _sum;
+    unsigned int _count;
+};
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "JitterBuffer.h"
+
+#include <cstring>
+
+JitterBuffer::JitterBuffer(unsigned int maxDepth) {
+    _maxDepth = maxDepth;
+    _depth = 0;
+    _synced = false;
+    _transit = 0;
+    _deviation = 0;
+    _newest = 0;
+    _played = 0;
+    _playedAny = false;
+    _count = 0;
+    reset();
+}
+
+void JitterBuffer::setMaxDepth(unsigned int maxDepth) {
+    _maxDepth = maxDepth;
+    if (_depth > maxDepth) _depth = maxDepth;
+}
+
+uint32_t JitterBuffer::playout(uint32_t timestamp) const {
+    return timestamp + _transit + _depth;
+}
+
+void JitterBuffer::push(const char* message, int length, uint32_t timestamp, uint32_t arrival) {
+    if ((length <= 0) || (length > JITTER_BUFFER_MESSAGE_SIZE)) {
+        _dropped++;
+        return;
+    }
+    
+    // The transit time includes the offset between the two clocks, which
+    // doesn't matter since only its changes set the depth
+    uint32_t transit = arrival - timestamp;
+    if (_synced) {
+        int32_t error = (int32_t)(transit - _transit);
+        if ((error > JITTER_BUFFER_RESYNC) || (error < -JITTER_BUFFER_RESYNC)
+                || ((int32_t)(timestamp - _newest) < -JITTER_BUFFER_RESYNC)) {
+            // The sender restarted, nothing held or played out before
+            // means anything on its new clock
+            _dropped += _count;
+            _count = 0;
+            _playedAny = false;
+            _synced = false;
+            _resyncs++;
+        }
+    }
+    if (!_synced) {
+        _transit = transit;
+        _newest = timestamp;
+        _synced = true;
+    }
+    else {
+        if ((int32_t)(arrival - playout(timestamp)) > 0) {
+            _late++;
+        }
+        if ((int32_t)(timestamp - _newest) < 0) {
+            _reordered++;
+        }
+        else {
+            _newest = timestamp;
+        }
+        int32_t error = (int32_t)(transit - _transit);
+        _transit += error / (1 << JITTER_BUFFER_SMOOTHING);
+        int deviation = (error < 0) ? -error : error;
+        _deviation += (deviation - (int)_deviation) / (1 << JITTER_BUFFER_SMOOTHING);
+        _depth = _deviation * JITTER_BUFFER_DEPTH_FACTOR;
+        if (_depth > _maxDepth) _depth = _maxDepth;
+    }
+    
+    // Too old to play out without going backwards
+    if (_playedAny && ((int32_t)(timestamp - _played) <= 0)) {
+        _dropped++;
+        return;
+    }
+    
+    int index = _count;
+    while ((index > 0) && ((int32_t)(_slots[index - 1].timestamp - timestamp) > 0)) {
+        index--;
+    }
+    if ((index > 0) && (_slots[index - 1].timestamp == timestamp)) {
+        // A repeated copy
+        _dropped++;
+        return;
+    }
+    if (_count == JITTER_BUFFER_SLOTS) {
+        _dropped++;
+        if (index == 0) return;
+        remove(0);
+        index--;
+    }
+    for (int i = _count; i > index; i--) {
+        _slots[i] = _slots[i - 1];
+    }
+    _slots[index].length = length;
+    _slots[index].timestamp = timestamp;
+    _slots[index].arrival = arrival;
+    memcpy(_slots[index].message, message, length);
+    _count++;
+}
+
+int JitterBuffer::pop(char* buffer, uint32_t now, uint32_t* arrival) {
+    if (wait(now) != 0) return -1;
+    
+    // Skip anything a newer command of the same type that is also due replaces
+    bool replaced = true;
+    while (replaced) {
+        replaced = false;
+        for (int i = 1; i < _count; i++) {
+            if (enabled() && ((int32_t)(now - playout(_slots[i].timestamp)) < 0)) break;
+            if (_slots[i].message[0] == _slots[0].message[0]) {
+                replaced = true;
+                break;
+            }
+        }
+        if (replaced) {
+            remove(0);
+            _dropped++;
+        }
+    }
+    
+    int length = _slots[0].length;
+    memcpy(buffer, _slots[0].message, length);
+    if (arrival) *arrival = _slots[0].arrival;
+    _played = _slots[0].timestamp;
+    _playedAny = true;
+    remove(0);
+    return length;
+}
+
+int JitterBuffer::wait(uint32_t now) const {
+    if (_count == 0) return -1;
+    if (!enabled()) return 0;
+    int32_t wait = (int32_t)(playout(_slots[0].timestamp) - now);
+    return (wait < 0) ? 0 : wait;
+}
+
+void JitterBuffer::remove(int index) {
+    _count--;
+    for (int i = index; i < _count; i++) {
+        _slots[i] = _slots[i + 1];
+    }
+}
+
+void JitterBuffer::reset() {
+    _late = 0;
+    _dropped = 0;
+    _reordered = 0;
+    _resyncs = 0;
+}
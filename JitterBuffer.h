@@ -0,0 +1,169 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_JITTERBUFFER_H
+#define SORO_JITTERBUFFER_H
+
+#include "mbed.h"
+
+// Commands held waiting for their playout time, extra ones drop the oldest
+#define JITTER_BUFFER_SLOTS 8
+
+// Largest command kept
+#define JITTER_BUFFER_MESSAGE_SIZE 50
+
+// The playout depth is this many times the mean deviation of the transit time
+#define JITTER_BUFFER_DEPTH_FACTOR 4
+
+// Weight given to each new sample in the transit estimates, as a shift
+#define JITTER_BUFFER_SMOOTHING 4
+
+// A transit time this far from the mean, or a timestamp this far behind the
+// newest, means the sender's clock restarted, in us. Well past any depth
+// worth holding commands for, and the longest commands on a restarted clock
+// can be dropped as too old before it is noticed.
+#define JITTER_BUFFER_RESYNC 250000
+
+/** Plays traced commands out on a steady local clock
+ *
+ * Each command is held until its sender timestamp plus the mean transit
+ * time plus a playout depth, so commands sent at a steady rate come out at
+ * a steady rate however bunched up they arrive. The depth follows the mean
+ * deviation of the transit time, so it grows when the network gets bursty
+ * and shrinks again when it calms down, but never past the maximum. A max
+ * depth of 0 turns the buffer off for the lowest latency.
+ *
+ * Commands are played out in sender timestamp order, so they must all come
+ * from one sender clock. One that arrives after a newer one has been
+ * played out is dropped. If the sender restarts, its timestamps jump by far
+ * more than any network delay, so the buffer drops what it holds and
+ * starts over from the first command on the new clock, as it did from the
+ * very first one. When several commands of the same type are due
+ * at once, only the newest is played out, so a stall doesn't replay a
+ * backlog.
+ *
+ * Example:
+ * @code
+ * JitterBuffer jitter(40000);
+ *
+ * jitter.push(message, length, trace.timestamp(), trace.receivedAt());
+ * // ...
+ * uint32_t arrival;
+ * int len = jitter.pop(buffer, us_ticker_read(), &arrival);
+ * @endcode
+ */
+class JitterBuffer {
+
+public:
+    /** Create an empty buffer
+     *
+     * @param maxDepth Longest a command may be held past the mean transit time, in us, 0 to turn the buffer off
+     */
+    JitterBuffer(unsigned int maxDepth);
+
+    /** Change the maximum depth, 0 turns the buffer off and plays out anything held */
+    void setMaxDepth(unsigned int maxDepth);
+
+    inline bool enabled() const {
+        return _maxDepth > 0;
+    }
+
+    /** Hold a command until its playout time
+     *
+     * @param message Command to copy, at most JITTER_BUFFER_MESSAGE_SIZE bytes
+     * @param timestamp When the sender sent it, in the sender's us
+     * @param arrival When it was received, from us_ticker_read()
+     */
+    void push(const char* message, int length, uint32_t timestamp, uint32_t arrival);
+
+    /** Take the next command that is due
+     *
+     * @param buffer Holds at least JITTER_BUFFER_MESSAGE_SIZE bytes
+     * @param now The time, from us_ticker_read()
+     * @param arrival If not NULL, receives the arrival given to push() with the command
+     * @returns The length of the command, or -1 if none is due yet
+     */
+    int pop(char* buffer, uint32_t now, uint32_t* arrival = NULL);
+
+    /** Time until the next command is due, in us, or -1 if the buffer is empty */
+    int wait(uint32_t now) const;
+
+    /** Current playout depth, in us */
+    inline unsigned int depth() const {
+        return _depth;
+    }
+
+    inline unsigned int maxDepth() const {
+        return _maxDepth;
+    }
+
+    /** Commands that arrived after their playout time */
+    inline unsigned int late() const {
+        return _late;
+    }
+
+    /** Commands thrown away, because something newer had already been
+     * played out, the buffer was full, or a newer command of the same type
+     * was due at the same time
+     */
+    inline unsigned int dropped() const {
+        return _dropped;
+    }
+
+    /** Commands that arrived with an older timestamp than one before them */
+    inline unsigned int reordered() const {
+        return _reordered;
+    }
+
+    /** Times the sender's clock restarted */
+    inline unsigned int resyncs() const {
+        return _resyncs;
+    }
+
+    /** Clear the counters, the transit estimates are kept */
+    void reset();
+
+protected:
+    struct Slot {
+        int length;
+        uint32_t timestamp;
+        uint32_t arrival;
+        char message[JITTER_BUFFER_MESSAGE_SIZE];
+    };
+
+    uint32_t playout(uint32_t timestamp) const;
+    void remove(int index);
+
+    unsigned int _maxDepth;
+    unsigned int _depth;
+    bool _synced;               // the transit estimates have a sample
+    uint32_t _transit;          // mean of arrival - timestamp
+    unsigned int _deviation;    // mean deviation from _transit
+    uint32_t _newest;           // newest timestamp received
+    uint32_t _played;           // newest timestamp played out
+    bool _playedAny;
+
+    unsigned int _late;
+    unsigned int _dropped;
+    unsigned int _reordered;
+    unsigned int _resyncs;
+
+    Slot _slots[JITTER_BUFFER_SLOTS];   // in timestamp order
+    int _count;
+};
+
+#endif
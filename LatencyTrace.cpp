@@ -0,0 +1,92 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "LatencyTrace.h"
+
+LatencyTrace::LatencyTrace(unsigned int bucketWidth) : _latency(bucketWidth) {
+    _pending = false;
+    _stale = false;
+    _sequence = 0;
+    _timestamp = 0;
+    reset();
+}
+
+int LatencyTrace::received(char* message, int length) {
+    _receivedAt = us_ticker_read();
+    _pending = true;
+    _stale = false;
+    
+    unsigned char type = (unsigned char)message[0];
+    if ((type & 0x80) || !(type & MBED_MESSAGE_TRACED) || (length < 1 + LATENCY_TRACE_SIZE)) {
+        return length;
+    }
+    message[0] = type & ~MBED_MESSAGE_TRACED;
+    length -= LATENCY_TRACE_SIZE;
+    const unsigned char* trailer = (const unsigned char*)message + length;
+    unsigned short sequence = trailer[0] | (trailer[1] << 8);
+    _timestamp = trailer[2] | (trailer[3] << 8) | (trailer[4] << 16) | ((uint32_t)trailer[5] << 24);
+    
+    // Just behind the last sequence is a late duplicate, not a gap. Far
+    // behind it, the sender has restarted and nothing was lost.
+    short gap = (short)(sequence - _sequence);
+    if (_synced) {
+        if ((gap <= 0) && (gap > -LATENCY_TRACE_STALE_WINDOW)) {
+            _stale = true;
+            return length;
+        }
+        if (gap > 0) {
+            _lost += gap - 1;
+        }
+    }
+    _sequence = sequence;
+    _synced = true;
+    _traced++;
+    return length;
+}
+
+void LatencyTrace::actuated() {
+    if (!_pending) return;
+    _latency.add(us_ticker_read() - _receivedAt);
+    _pending = false;
+}
+
+void LatencyTrace::actuated(uint32_t receivedAt) {
+    actuated(receivedAt, us_ticker_read());
+}
+
+void LatencyTrace::actuated(uint32_t receivedAt, uint32_t actuatedAt) {
+    _latency.add(actuatedAt - receivedAt);
+}
+
+int LatencyTrace::append(char* message, int length, unsigned short sequence, uint32_t timestamp) {
+    message[0] |= MBED_MESSAGE_TRACED;
+    unsigned char* trailer = (unsigned char*)message + length;
+    trailer[0] = sequence & 0xFF;
+    trailer[1] = sequence >> 8;
+    trailer[2] = timestamp & 0xFF;
+    trailer[3] = (timestamp >> 8) & 0xFF;
+    trailer[4] = (timestamp >> 16) & 0xFF;
+    trailer[5] = timestamp >> 24;
+    return length + LATENCY_TRACE_SIZE;
+}
+
+void LatencyTrace::reset() {
+    _latency.reset();
+    _lost = 0;
+    _traced = 0;
+    _synced = false;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_LATENCYTRACE_H
+#define SORO_LATENCYTRACE_H
+
+#include "mbed.h"
+#include "Histogram.h"
+
+/* A command message whose type byte has this bit set carries a trace
+ * trailer: a sequence number (uint16) and the sender's timestamp in us
+ * (uint32), both little endian, after the normal message. Only types below
+ * 0x80 can be traced, the diagnostic types above that are never stripped.
+ */
+#define MBED_MESSAGE_TRACED 0x40
+#define LATENCY_TRACE_SIZE 6
+
+/* A traced message at most this far behind the last sequence number is a
+ * late or repeated copy. Further back than that, the sender has restarted.
+ */
+#define LATENCY_TRACE_STALE_WINDOW 64
+
+/** Measures how long commands take from arriving to reaching the outputs
+ *
+ * Call received() as soon as a message is read, which also strips any
+ * trace trailer, and actuated() once the command has been written out.
+ * Sequence numbers from traced messages are used to count lost messages.
+ * A sequence number far behind the last one means the sender restarted, and
+ * counting starts again from it.
+ *
+ * Example:
+ * @code
+ * int len = ethernet.read(buffer, 50);
+ * if (len != -1) {
+ *     len = latency.received(buffer, len);
+ *     // ...
+ *     setDrive(buffer);
+ *     latency.actuated();
+ * }
+ * @endcode
+ */
+class LatencyTrace {
+
+public:
+    /** Create a trace with no samples
+     *
+     * @param bucketWidth Width of each latency histogram bucket in us
+     */
+    LatencyTrace(unsigned int bucketWidth = 50);
+
+    /** Note the arrival of a message, and strip its trace trailer if it has one
+     *
+     * @returns The length of the message without the trailer
+     */
+    int received(char* message, int length);
+
+    /** Note that the last received message has reached the outputs */
+    void actuated();
+
+    /** Note that a message has reached the outputs, for messages handed to
+     * another thread before being applied
+     *
+     * @param receivedAt receivedAt() as it was right after the message was received
+     */
+    void actuated(uint32_t receivedAt);
+
+    /** Note that a message reached the outputs at an earlier time, for
+     * outputs written from an interrupt and collected later
+     *
+     * @param receivedAt receivedAt() as it was right after the message was received
+     * @param actuatedAt us_ticker_read() when the outputs were written
+     */
+    void actuated(uint32_t receivedAt, uint32_t actuatedAt);
+
+    /** Append a trace trailer to a message and flag it, for senders
+     *
+     * @returns The length of the traced message
+     */
+    static int append(char* message, int length, unsigned short sequence, uint32_t timestamp);
+
+    /** Time from received() to actuated(), in us */
+    inline const Histogram& latency() const {
+        return _latency;
+    }
+
+    /** Messages missing from the traced sequence */
+    inline unsigned int lost() const {
+        return _lost;
+    }
+
+    /** Number of traced messages received */
+    inline unsigned int traced() const {
+        return _traced;
+    }
+
+    /** Sequence number of the last traced message */
+    inline unsigned short sequence() const {
+        return _sequence;
+    }
+
+    /** Whether the last message received was traced and up to
+     * LATENCY_TRACE_STALE_WINDOW behind the one before it, so it is a late
+     * or repeated copy
+     */
+    inline bool stale() const {
+        return _stale;
+    }
+
+    /** When the last message was received, in us */
+    inline uint32_t receivedAt() const {
+        return _receivedAt;
+    }
+
+    /** Sender timestamp of the last traced message */
+    inline uint32_t timestamp() const {
+        return _timestamp;
+    }
+
+    /** Clear the samples and counts, and start the sequence again from the
+     * next traced message
+     */
+    void reset();
+
+protected:
+    Histogram _latency;
+    uint32_t _receivedAt;
+    bool _pending;
+    bool _stale;
+    bool _synced;               // a traced message has set _sequence
+    unsigned int _lost;
+    unsigned int _traced;
+    unsigned short _sequence;
+    uint32_t _timestamp;
+};
+
+#endif
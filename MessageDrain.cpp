@@ -0,0 +1,142 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MessageDrain.h"
+
+#include <cstring>
+
+MessageDrain::MessageDrain(Soro::MbedChannel& channel, LatencyTrace& trace, unsigned int timeout) :
+        _channel(channel), _trace(trace) {
+    _jitter = NULL;
+    _timeout = timeout;
+    _arrivals = 0;
+    _dropped = 0;
+    for (int i = 0; i < MESSAGE_DRAIN_SLOTS; i++) {
+        _slots[i].length = 0;
+    }
+}
+
+int MessageDrain::read(char* buffer, uint32_t* receivedAt) {
+    int length = take(buffer, receivedAt);
+    if (length != -1) {
+        return length;
+    }
+    
+    uint32_t start = us_ticker_read();
+    unsigned int timeout = _timeout;
+    while (1) {
+        // Don't sleep past the next message the jitter buffer has due
+        if (_jitter) {
+            int due = _jitter->wait(us_ticker_read());
+            if ((due != -1) && ((unsigned int)(due + 999) / 1000 < timeout)) {
+                timeout = (due + 999) / 1000;
+            }
+        }
+        fill(timeout);
+        length = take(buffer, receivedAt);
+        if ((length != -1) || !_jitter || (_jitter->wait(us_ticker_read()) == -1)) {
+            return length;
+        }
+        unsigned int elapsed = (us_ticker_read() - start) / 1000;
+        if (elapsed >= _timeout) {
+            return -1;
+        }
+        timeout = _timeout - elapsed;
+    }
+}
+
+/* Hands out a message that is due from the jitter buffer, or else the
+ * oldest one kept
+ */
+int MessageDrain::take(char* buffer, uint32_t* receivedAt) {
+    if (_jitter) {
+        int length = _jitter->pop(buffer, us_ticker_read(), receivedAt);
+        if (length != -1) {
+            return length;
+        }
+    }
+    
+    int oldest = -1;
+    for (int i = 0; i < MESSAGE_DRAIN_SLOTS; i++) {
+        if ((_slots[i].length > 0) && ((oldest == -1) || (_slots[i].arrival < _slots[oldest].arrival))) {
+            oldest = i;
+        }
+    }
+    if (oldest == -1) {
+        return -1;
+    }
+    int length = _slots[oldest].length;
+    memcpy(buffer, _slots[oldest].message, length);
+    if (receivedAt) *receivedAt = _slots[oldest].receivedAt;
+    _slots[oldest].length = 0;
+    return length;
+}
+
+/* Waits for one message, then takes whatever else is already waiting
+ */
+void MessageDrain::fill(unsigned int timeout) {
+    char message[MESSAGE_DRAIN_MESSAGE_SIZE];
+    _channel.setTimeout(timeout);
+    int length = _channel.read(&message[0], sizeof(message));
+    if (length <= 0) {
+        return;
+    }
+    keep(&message[0], length);
+    
+    _channel.setTimeout(0);
+    for (int i = 1; i < MESSAGE_DRAIN_MAX_BATCH; i++) {
+        length = _channel.read(&message[0], sizeof(message));
+        if (length <= 0) break;
+        keep(&message[0], length);
+    }
+}
+
+void MessageDrain::keep(char* message, int length) {
+    int untraced = _trace.received(message, length);
+    if (_jitter && _jitter->enabled() && (untraced < length)) {
+        // The jitter buffer puts traced messages in order itself, so even
+        // the stale ones go to it
+        _jitter->push(message, untraced, _trace.timestamp(), _trace.receivedAt());
+        return;
+    }
+    length = untraced;
+    if (_trace.stale()) {
+        _dropped++;
+        return;
+    }
+    
+    // The same type replaces the older message, otherwise use a free slot
+    int slot = -1;
+    for (int i = 0; i < MESSAGE_DRAIN_SLOTS; i++) {
+        if ((_slots[i].length > 0) && (_slots[i].message[0] == message[0])) {
+            slot = i;
+            _dropped++;
+            break;
+        }
+        if ((slot == -1) && (_slots[i].length == 0)) {
+            slot = i;
+        }
+    }
+    if (slot == -1) {
+        _dropped++;
+        return;
+    }
+    memcpy(_slots[slot].message, message, length);
+    _slots[slot].length = length;
+    _slots[slot].arrival = _arrivals++;
+    _slots[slot].receivedAt = _trace.receivedAt();
+}
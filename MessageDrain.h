@@ -0,0 +1,118 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_MESSAGEDRAIN_H
+#define SORO_MESSAGEDRAIN_H
+
+#include "mbed.h"
+#include "mbedchannel.h"
+#include "LatencyTrace.h"
+#include "JitterBuffer.h"
+
+// Different message types held at once, extra types are dropped
+#define MESSAGE_DRAIN_SLOTS 4
+
+// Largest message kept
+#define MESSAGE_DRAIN_MESSAGE_SIZE 50
+
+// Most datagrams drained in one go, so a flood can't hold up the main loop
+#define MESSAGE_DRAIN_MAX_BATCH 32
+
+/** Reads an MbedChannel so a backlog costs one command instead of many
+ *
+ * When it runs out of messages, read() waits for one as MbedChannel::read()
+ * would, then drains everything else already waiting without blocking. Only
+ * the newest message of each type is kept, and traced messages older than
+ * the last one seen are dropped. The kept messages are handed out one at a
+ * time in the order they arrived.
+ *
+ * Every message goes through the LatencyTrace, which strips trace trailers.
+ *
+ * With a JitterBuffer set, traced messages go through it instead of being
+ * kept, and read() hands them out as they come due. Untraced messages and
+ * diagnostics are still handed out as soon as they arrive.
+ *
+ * Example:
+ * @code
+ * MessageDrain messages(ethernet, latency, 500);
+ *
+ * while (1) {
+ *     uint32_t receivedAt;
+ *     int len = messages.read(buffer, &receivedAt);
+ *     if (len == -1) {
+ *         // timed out
+ *     }
+ *     // ...
+ *     latency.actuated(receivedAt);
+ * }
+ * @endcode
+ */
+class MessageDrain {
+
+public:
+    /** Create a drain on a channel
+     *
+     * @param channel Channel to read from
+     * @param trace Notified of every message received
+     * @param timeout How long read() waits for a message when there are none, in ms
+     */
+    MessageDrain(Soro::MbedChannel& channel, LatencyTrace& trace, unsigned int timeout);
+
+    /** Get the next message, waiting for one if none are left
+     *
+     * @param buffer Holds at least MESSAGE_DRAIN_MESSAGE_SIZE bytes
+     * @param receivedAt If not NULL, receives when the message came off the
+     * channel, for LatencyTrace::actuated(uint32_t)
+     * @returns The length of the message, or -1 if none arrived in time
+     */
+    int read(char* buffer, uint32_t* receivedAt = NULL);
+
+    /** Play traced messages out through a jitter buffer
+     *
+     * @param jitter Buffer to use, or NULL to hand everything out at once
+     */
+    inline void setJitterBuffer(JitterBuffer* jitter) {
+        _jitter = jitter;
+    }
+
+    /** Number of messages replaced by newer ones or dropped as stale */
+    inline unsigned int dropped() {
+        return _dropped;
+    }
+
+protected:
+    struct Slot {
+        int length;             // 0 if empty
+        unsigned int arrival;   // order kept in
+        uint32_t receivedAt;    // us, from the LatencyTrace
+        char message[MESSAGE_DRAIN_MESSAGE_SIZE];
+    };
+
+    int take(char* buffer, uint32_t* receivedAt);
+    void fill(unsigned int timeout);
+    void keep(char* message, int length);
+
+    Soro::MbedChannel& _channel;
+    LatencyTrace& _trace;
+    JitterBuffer* _jitter;
+    unsigned int _timeout;
+    unsigned int _arrivals;
+    unsigned int _dropped;
+    Slot _slots[MESSAGE_DRAIN_SLOTS];
+};
+
+#endif
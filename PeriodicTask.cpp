@@ -0,0 +1,84 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PeriodicTask.h"
+
+PeriodicTask::PeriodicTask(unsigned int period, unsigned int jitterBucket, unsigned int executionBucket) :
+        _jitter(jitterBucket), _execution(executionBucket) {
+    _period = period;
+    _thread = NULL;
+    _released = 0;
+    _handled = 0;
+    _inCycle = false;
+    _overruns = 0;
+}
+
+void PeriodicTask::start() {
+    _thread = osThreadGetId();
+    _released = 0;
+    _handled = 0;
+    _inCycle = false;
+    _start = us_ticker_read();
+    _ticker.attach_us(this, &PeriodicTask::release, _period);
+}
+
+void PeriodicTask::stop() {
+    _ticker.detach();
+}
+
+void PeriodicTask::release() {
+    _released++;
+    osSignalSet(_thread, PERIODIC_TASK_SIGNAL);
+}
+
+void PeriodicTask::notify() {
+    if (_thread) {
+        osSignalSet(_thread, PERIODIC_TASK_EVENT_SIGNAL);
+    }
+}
+
+bool PeriodicTask::wait() {
+    if (_inCycle) {
+        _execution.add(us_ticker_read() - _wake);
+    }
+    
+    // Any signal ends the wait, and all of them are cleared
+    osEvent event = Thread::signal_wait(0);
+    _wake = us_ticker_read();
+    _inCycle = true;
+    if (!(event.value.signals & PERIODIC_TASK_SIGNAL)) {
+        return false;
+    }
+    
+    // Releases coalesce into one signal if the last cycle ran long
+    uint32_t released = _released;
+    if (released - _handled > 1) {
+        _overruns += released - _handled - 1;
+    }
+    _handled = released;
+    
+    // Unsigned differences stay right when the us ticker wraps
+    int late = (int)(_wake - (_start + released * _period));
+    _jitter.add(late > 0 ? late : 0);
+    return true;
+}
+
+void PeriodicTask::resetStats() {
+    _jitter.reset();
+    _execution.reset();
+    _overruns = 0;
+}
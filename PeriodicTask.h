@@ -0,0 +1,112 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_PERIODICTASK_H
+#define SORO_PERIODICTASK_H
+
+#include "mbed.h"
+#include "rtos.h"
+#include "Histogram.h"
+
+// Thread signals set on every release, and by notify()
+#define PERIODIC_TASK_SIGNAL 0x1
+#define PERIODIC_TASK_EVENT_SIGNAL 0x2
+
+/** Runs a job at an exact rate on an RTOS thread, and keeps timing stats
+ *
+ * A Ticker releases the thread, so the period doesn't stretch by however
+ * long the job takes the way wait() after the job does. Each release is
+ * timed against when it should have happened, and each cycle against
+ * how long the job ran for. Events can also wake the thread between
+ * releases with notify().
+ *
+ * Example:
+ * @code
+ * PeriodicTask task(4000);    // 250Hz
+ *
+ * int main() {
+ *     task.start();
+ *     while (1) {
+ *         task.wait();
+ *         // the job
+ *     }
+ * }
+ * @endcode
+ */
+class PeriodicTask {
+
+public:
+    /** Create a stopped task
+     *
+     * @param period Time between releases in us
+     * @param jitterBucket Width of each release jitter histogram bucket in us
+     * @param executionBucket Width of each execution time histogram bucket in us
+     */
+    PeriodicTask(unsigned int period, unsigned int jitterBucket = 10, unsigned int executionBucket = 100);
+
+    /** Start releasing the calling thread */
+    void start();
+
+    /** Stop releasing */
+    void stop();
+
+    /** Block until the next release or notify(). Also ends timing of the previous cycle.
+     *
+     * @returns true for a release, false if only notify() woke the thread
+     */
+    bool wait();
+
+    /** Wake the thread for an event without waiting for the next release.
+     * Safe to call from interrupt handlers.
+     */
+    void notify();
+
+    /** How late each release woke the thread, in us */
+    inline const Histogram& jitter() {
+        return _jitter;
+    }
+
+    /** How long each cycle ran before calling wait() again, in us */
+    inline const Histogram& execution() {
+        return _execution;
+    }
+
+    /** Number of releases missed because a cycle ran too long */
+    inline unsigned int overruns() {
+        return _overruns;
+    }
+
+    /** Clear the stats, only from the task's own thread */
+    void resetStats();
+
+protected:
+    void release();
+
+    Ticker _ticker;
+    osThreadId _thread;
+    unsigned int _period;           // us
+    uint32_t _start;                // us ticker time of start()
+    volatile uint32_t _released;
+    uint32_t _handled;
+    uint32_t _wake;                 // us ticker time the current cycle woke
+    bool _inCycle;
+    Histogram _jitter;
+    Histogram _execution;
+    unsigned int _overruns;
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SORO_RINGBUFFER_H
+#define SORO_RINGBUFFER_H
+
+#include "mbed.h"
+
+/** Lock-free single producer, single consumer ring buffer
+ *
+ * One side (usually an interrupt handler) may only call push(), and the
+ * other side (usually the main loop) may only call pop(). The head and tail
+ * indices are each written by exactly one side, and word sized stores are atomic on the Cortex-M3, so no locking is needed.
+ * The barriers make sure an item is stored before the index publishing it.
+ *
+ * Size must be a power of two. One slot is kept free to tell a full buffer
+ * from an empty one, so the usable capacity is Size - 1.
+ */
+template <typename T, unsigned int Size>
+class RingBuffer {
+
+public:
+    RingBuffer() : _head(0), _tail(0) { }
+
+    /** Add an item to the buffer
+     *
+     * @returns false if the buffer is full and the item was dropped
+     */
+    bool push(const T& item) {
+        unsigned int head = _head;
+        unsigned int next = (head + 1) & (Size - 1);
+        if (next == _tail) return false;
+        _items[head] = item;
+        __DMB();
+        _head = next;
+        return true;
+    }
+
+    /** Remove the oldest item from the buffer
+     *
+     * @returns false if the buffer is empty
+     */
+    bool pop(T& item) {
+        unsigned int tail = _tail;
+        if (tail == _head) return false;
+        __DMB();
+        item = _items[tail];
+        __DMB();
+        _tail = (tail + 1) & (Size - 1);
+        return true;
+    }
+
+    /** Look at the oldest item without removing it
+     *
+     * @returns false if the buffer is empty
+     */
+    bool peek(T& item) const {
+        unsigned int tail = _tail;
+        if (tail == _head) return false;
+        __DMB();
+        item = _items[tail];
+        return true;
+    }
+
+    /** Remove up to maxCount of the oldest items into a flat array
+     *
+     * @returns The number of items copied
+     */
+    unsigned int pop(T* items, unsigned int maxCount) {
+        unsigned int count = 0;
+        unsigned int tail = _tail;
+        unsigned int head = _head;
+        __DMB();
+        while ((tail != head) && (count < maxCount)) {
+            items[count++] = _items[tail];
+            tail = (tail + 1) & (Size - 1);
+        }
+        __DMB();
+        _tail = tail;
+        return count;
+    }
+
+    /** Number of items currently waiting in the buffer */
+    unsigned int count() const {
+        return (_head - _tail) & (Size - 1);
+    }
+
+    bool empty() const {
+        return _head == _tail;
+    }
+
+    /** Maximum number of items the buffer can hold */
+    unsigned int capacity() const {
+        return Size - 1;
+    }
+
+private:
+    // Size must be a power of two for the index masking to work
+    typedef char SizeMustBePowerOfTwo[((Size & (Size - 1)) == 0) ? 1 : -1];
+
+    T _items[Size];
+    volatile unsigned int _head;
+    volatile unsigned int _tail;
+};
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SerialForwarder.h"
+#include "Cobs.h"
+
+using namespace Soro;
+
+SerialForwarder::SerialForwarder(Serial& serial, MbedChannel& channel, char delimiter)
+        : _serial(serial), _channel(channel) {
+    _delimiter = delimiter;
+    _sequence = 0;
+    _compress = false;
+    _lastKey = 0;
+    _lastTimestamp = 0;
+    _recordOpen = false;
+    _dropping = false;
+    _recordLength = 0;
+    _recordStart = 0;
+    _lastByte = 0;
+    _pending = false;
+    _pendingSince = 0;
+    _overruns = 0;
+    _clock.start();
+    _serial.attach(this, &SerialForwarder::onReceive, Serial::RxIrq);
+}
+
+/* Runs in the UART interrupt. Drain the hardware FIFO completely,
+ * otherwise the interrupt fires again right away.
+ */
+void SerialForwarder::onReceive() {
+    while (_serial.readable()) {
+        char c = (char)_serial.getc();
+        _lastByte = _clock.read_us();
+        if (c == _delimiter) {
+            closeRecord();
+            continue;
+        }
+        if (!_recordOpen) {
+            _recordOpen = true;
+            _recordStart = _lastByte;
+            // Only this side adds records, so if there is room for one now
+            // there still will be when it closes
+            _dropping = (_records.count() == _records.capacity());
+        }
+        if (_dropping || !_rx.push(c)) {
+            _overruns++;
+            continue;
+        }
+        if (++_recordLength == SERIAL_FORWARD_RECORD_SIZE) {
+            closeRecord();
+        }
+    }
+}
+
+/* Ends the open record. Runs in the UART interrupt, or with it masked.
+ */
+void SerialForwarder::closeRecord() {
+    if (_recordLength > 0) {
+        Record record;
+        record.length = _recordLength;
+        record.timestamp = _recordStart;
+        _records.push(record);
+        if (!_pending) {
+            _pendingSince = _clock.read_us();
+            _pending = true;
+        }
+    }
+    _recordOpen = false;
+    _dropping = false;
+    _recordLength = 0;
+}
+
+bool SerialForwarder::poll() {
+    // A record the line went quiet in the middle of is sent as it is
+    if (_recordOpen && ((unsigned int)_clock.read_us() - _lastByte >= SERIAL_FORWARD_IDLE_MS * 1000)) {
+        __disable_irq();
+        if (_recordOpen) closeRecord();
+        __enable_irq();
+    }
+    
+    unsigned int count = _records.count();
+    if (count == 0) {
+        return false;
+    }
+    if (!_pending) {
+        // Records arrived while the last batch was being sent
+        _pendingSince = _clock.read_us();
+        _pending = true;
+    }
+    unsigned int age = (unsigned int)_clock.read_us() - _pendingSince;
+    if ((_rx.count() < SERIAL_FORWARD_BATCH_SIZE) && (count < _records.capacity() / 2)
+            && (age < SERIAL_FORWARD_MAX_AGE_MS * 1000)) {
+        return false;
+    }
+    send();
+    return true;
+}
+
+void SerialForwarder::flush() {
+    __disable_irq();
+    if (_recordOpen) closeRecord();
+    __enable_irq();
+    while (!_records.empty()) {
+        send();
+    }
+}
+
+void SerialForwarder::send() {
+    char* end = _batch;
+    *end++ = (char)(_compress ? MBED_MESSAGE_SERIAL_RECORDS_COMPRESSED : MBED_MESSAGE_SERIAL_RECORDS);
+    *end++ = _sequence & 0xFF;
+    *end++ = _sequence >> 8;
+    
+    if (_compress) {
+        // A key batch can be decoded without the ones before it
+        uint32_t now = _clock.read_us();
+        bool key = (_sequence == 0) || (now - _lastKey >= SERIAL_FORWARD_KEY_INTERVAL_MS * 1000);
+        if (key) {
+            _encoder.reset();
+            _lastTimestamp = 0;
+            _lastKey = now;
+        }
+        *end++ = key ? SERIAL_RECORDS_KEY : 0;
+    }
+    
+    Record record;
+    while (_records.peek(record)) {
+        int length = _compress ? 5 + TELEMETRY_MAX_ENCODED_SIZE(record.length) : 4 + record.length;
+        // Encoded record and its terminating zero
+        if (Cobs::maxEncodedSize(length) + 1 > (_batch + SERIAL_FORWARD_BATCH_SIZE) - end) break;
+        _records.pop(record);
+        
+        end += Cobs::encode(_record, pack(record, _record), end);
+        *end++ = 0;
+    }
+    // Whatever didn't fit goes in the next batch straight away
+    _pending = !_records.empty();
+    
+    _channel.sendMessage(_batch, end - _batch);
+    _sequence++;
+}
+
+/* Takes a record's bytes off the buffer and puts it together with its
+ * timestamp, ready for COBS
+ *
+ * @returns The length of the record
+ */
+int SerialForwarder::pack(const Record& record, char* out) {
+    if (!_compress) {
+        out[0] = record.timestamp & 0xFF;
+        out[1] = (record.timestamp >> 8) & 0xFF;
+        out[2] = (record.timestamp >> 16) & 0xFF;
+        out[3] = record.timestamp >> 24;
+        _rx.pop(&out[4], record.length);
+        return 4 + record.length;
+    }
+    int length = TelemetryCodec::putVarint(out, record.timestamp - _lastTimestamp);
+    _lastTimestamp = record.timestamp;
+    _rx.pop(_raw, record.length);
+    return length + _encoder.encode(_raw, record.length, &out[length]);
+}
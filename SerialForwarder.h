@@ -0,0 +1,144 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SORO_SERIALFORWARDER_H
+#define SORO_SERIALFORWARDER_H
+
+#include "mbed.h"
+#include "mbedchannel.h"
+#include "RingBuffer.h"
+#include "TelemetryCodec.h"
+#include "SerialRecords.h"
+
+// Bytes buffered between the UART interrupt and poll(). This has to cover
+// the longest time poll() can go uncalled at the configured baud rate.
+#define SERIAL_FORWARD_BUFFER_SIZE 4096
+
+// Records buffered between the UART interrupt and poll()
+#define SERIAL_FORWARD_RECORDS 64
+
+// Longest record, longer ones are split
+#define SERIAL_FORWARD_RECORD_SIZE 128
+
+// A record with no delimiter ends once the line has been quiet this long
+#define SERIAL_FORWARD_IDLE_MS 20
+
+// Largest batch sent in one datagram, kept well under the ethernet MTU
+#define SERIAL_FORWARD_BATCH_SIZE 1024
+
+// Buffered records older than this are sent even if the batch isn't full
+#define SERIAL_FORWARD_MAX_AGE_MS 20
+
+// Compressed batches restart from a fresh encoder at least this often, which
+// is also the longest a lost batch can keep the receiver from decoding
+#define SERIAL_FORWARD_KEY_INTERVAL_MS 1000
+
+/** Forwards records received on a serial port to an MbedChannel
+ *
+ * Bytes are pulled off the UART in its RX interrupt, so nothing is lost while
+ * the main loop is busy elsewhere. The stream is split into records at a
+ * delimiter byte, which is dropped, or when a record gets too long or the
+ * line goes quiet. Each record is stamped with the time its first byte
+ * arrived. The main loop calls poll(), which packs many records into each
+ * datagram instead of sending one per loop iteration. SerialRecords.h has
+ * the datagram format. Records dropped because the buffers were full are
+ * counted by overruns().
+ *
+ * Example:
+ * @code
+ * Serial dataSerial(p9, p10);
+ * SerialForwarder forwarder(dataSerial, ethernet);
+ *
+ * while (1) {
+ *     forwarder.poll();
+ *     // ...
+ * }
+ * @endcode
+ */
+class SerialForwarder {
+
+public:
+    /** Attach to the RX interrupt of a serial port
+     *
+     * @param serial Serial port to read from
+     * @param channel Channel to forward the data over
+     * @param delimiter Byte which ends each record
+     */
+    SerialForwarder(Serial& serial, Soro::MbedChannel& channel, char delimiter = '\n');
+
+    /** Send a batch if a full one is waiting or the oldest record is too old
+     *
+     * @returns true if a batch was sent
+     */
+    bool poll();
+
+    /** Send everything that is currently buffered */
+    void flush();
+
+    /** Number of bytes dropped because a buffer was full */
+    inline unsigned int overruns() {
+        return _overruns;
+    }
+
+    /** Compress records with a TelemetryEncoder before sending them */
+    inline void setCompression(bool compress) {
+        _compress = compress;
+    }
+
+    /** Sequence number of the next batch */
+    inline unsigned short sequence() {
+        return _sequence;
+    }
+
+protected:
+    struct Record {
+        unsigned int length;
+        uint32_t timestamp;
+    };
+
+    void onReceive();
+    void closeRecord();
+    void send();
+    int pack(const Record& record, char* out);
+
+    Serial& _serial;
+    Soro::MbedChannel& _channel;
+    char _delimiter;
+    RingBuffer<char, SERIAL_FORWARD_BUFFER_SIZE> _rx;
+    RingBuffer<Record, SERIAL_FORWARD_RECORDS> _records;
+    char _batch[SERIAL_FORWARD_BATCH_SIZE];
+    char _record[5 + TELEMETRY_MAX_ENCODED_SIZE(SERIAL_FORWARD_RECORD_SIZE)];
+    char _raw[SERIAL_FORWARD_RECORD_SIZE];
+    bool _compress;
+    uint32_t _lastKey;          // when the encoder was last reset
+    TelemetryEncoder _encoder;
+    uint32_t _lastTimestamp;    // of the record before, since the last key batch
+    Timer _clock;
+    unsigned short _sequence;
+
+    // The open record, only touched with the UART interrupt masked
+    bool _recordOpen;
+    bool _dropping;             // no room was left for it, so its bytes are dropped
+    unsigned int _recordLength;
+    uint32_t _recordStart;
+    volatile uint32_t _lastByte;
+
+    volatile bool _pending;
+    volatile unsigned int _pendingSince;
+    volatile unsigned int _overruns;
+};
+
+#endif
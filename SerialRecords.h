@@ -0,0 +1,49 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_SERIALRECORDS_H
+#define SORO_SERIALRECORDS_H
+
+/* Message types of a batch of serial records, sent from the mbed. Like the
+ * diagnostic types they are kept clear of the MbedMessageType values in the
+ * soro repository.
+ */
+#define MBED_MESSAGE_SERIAL_RECORDS 0xE0
+#define MBED_MESSAGE_SERIAL_RECORDS_COMPRESSED 0xE1
+
+// Flag of a compressed datagram which starts from a fresh encoder
+#define SERIAL_RECORDS_KEY 0x01
+
+/* Format of the datagrams sent by SerialForwarder. Values are little endian.
+ *
+ * A datagram is the MBED_MESSAGE_SERIAL_RECORDS type byte and a sequence
+ * number (uint16), then the records. Each record is its timestamp in us
+ * (uint32) followed by its bytes, COBS encoded and ended with a zero byte.
+ * A gap in the sequence numbers means datagrams were lost.
+ *
+ * A compressed datagram has the MBED_MESSAGE_SERIAL_RECORDS_COMPRESSED type
+ * byte instead, and a flags byte after the sequence number. Each record's
+ * timestamp is a varint of the time since the record before it, and its
+ * bytes are encoded by a TelemetryEncoder. Both carry on from one datagram
+ * to the next, except that the encoder is reset and the time counted from 0
+ * for a datagram flagged SERIAL_RECORDS_KEY. After a lost datagram, the
+ * receiver has to skip everything up to the next key datagram.
+ *
+ * This header doesn't need mbed.h, so receivers can use it too.
+ */
+
+#endif
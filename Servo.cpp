@@ -25,6 +25,9 @@
 #include "Servo.h"
 #include "mbed.h"
 
+// Pulsewidth at the centre position, in us
+#define CENTER_PULSE 1500
+
 static float clamp(float value, float min, float max) {
     if(value < min) {
         return min;
@@ -35,25 +38,123 @@ static float clamp(float value, float min, float max) {
     }
 }
 
-Servo::Servo(PinName pin) : _pwm(pin) {
+Servo::Servo(PinName pin, bool center) : _pwm(pin), _pin(pin) {
     calibrate();
-    write(0.5);
+    _rate = 0;
+    _settle = 0;
+    _from = 0x8000;
+    _start = 0;
+    _known = false;
+    _moving = false;
+    if (center) {
+        write_u16(0x8000);
+    }
+    else {
+        _p = 0x8000;
+    }
 }
 
 void Servo::write(float percent) {
-    float offset = _range * 2.0 * (percent - 0.5);
-    _pwm.pulsewidth(0.0015 + clamp(offset, -_range, _range));
-    _p = clamp(percent, 0.0, 1.0);
+    write_u16((unsigned short)(clamp(percent, 0.0f, 1.0f) * 65535 + 0.5f));
+}
+
+void Servo::write_u16(unsigned short value) {
+    _pwm.pulsewidth_us(pulsewidth(value));
+    track(value);
+}
+
+/* Starts the motion model towards a newly written position
+ */
+void Servo::track(unsigned short value) {
+    if (_rate == 0) {
+        // No model, so the horn is taken to be wherever it was last sent
+        _p = value;
+        _from = value;
+        _known = true;
+        _moving = false;
+        return;
+    }
+    uint32_t now = us_ticker_read();
+    if (_known) {
+        _from = estimate_u16();
+    }
+    else {
+        // No idea where it is, so assume the furthest it could have to go
+        _from = (value < 0x8000) ? 0xFFFF : 0;
+        _known = true;
+    }
+    _p = value;
+    _start = now;
+    _moving = true;
+}
+
+/* Time for the horn to travel between two positions, in us
+ */
+unsigned int Servo::travelTime(unsigned short from, unsigned short to) const {
+    if (_rate == 0) return 0;
+    unsigned int distance = (from > to) ? from - to : to - from;
+    return (unsigned int)((uint64_t)distance * 1000000 / _rate);
+}
+
+void Servo::motion(float speed, float load, float settle) {
+    _rate = (unsigned int)(clamp(speed * load, 0.0f, 1000.0f) * 65535 + 0.5f);
+    _settle = (unsigned int)(clamp(settle, 0.0f, 1000.0f) * 1000000 + 0.5f);
+}
+
+/* Ends the motion once the horn should be at rest. This has to happen
+ * within a clock wrap of the write, or the move looks like it only just
+ * started.
+ */
+void Servo::update(uint32_t now) const {
+    if (_moving && (now - _start >= travelTime(_from, _p) + _settle)) {
+        _from = _p;
+        _moving = false;
+    }
+}
+
+void Servo::update() const {
+    update(us_ticker_read());
+}
+
+unsigned short Servo::estimate_u16() {
+    uint32_t now = us_ticker_read();
+    update(now);
+    if (!_moving || (_rate == 0)) return _p;
+    uint32_t elapsed = now - _start;
+    uint64_t travel = (uint64_t)_rate * elapsed / 1000000;
+    if (_p > _from) {
+        if (travel < (unsigned int)(_p - _from)) return _from + (unsigned short)travel;
+    }
+    else if (travel < (unsigned int)(_from - _p)) {
+        return _from - (unsigned short)travel;
+    }
+    return _p;
+}
+
+float Servo::settleTime() const {
+    uint32_t now = us_ticker_read();
+    update(now);
+    if (!_moving) return 0;
+    uint32_t elapsed = now - _start;
+    unsigned int total = travelTime(_from, _p) + _settle;
+    return (total - elapsed) * 0.000001f;
+}
+
+int Servo::pulsewidth(unsigned short value) {
+    // Stretch 0-65535 to 0-65536 so the full range maps exactly onto the span
+    unsigned int q16 = value + (value >> 15);
+    return _minPulse + (int)((q16 * _span) >> 16);
 }
 
 void Servo::position(float degrees) {
-    float offset = _range * (degrees / _degrees);
-    _pwm.pulsewidth(0.0015 + clamp(offset, -_range, _range));
+    write_u16((unsigned short)clamp(32767.5f + degrees * _perDegree, 0.0f, 65535.0f));
 }
 
 void Servo::calibrate(float range, float degrees) {
-    _range = range;
-    _degrees = degrees;
+    int rangePulse = (int)(range * 1000000 + 0.5f);
+    _minPulse = CENTER_PULSE - rangePulse;
+    _span = 2 * rangePulse;
+    _perDegree = 32767.5f / degrees;
 }
 
 Servo& Servo::operator= (float percent) { 
@@ -62,6 +163,6 @@ Servo& Servo::operator= (float percent) {
 }
 
 Servo& Servo::operator= (Servo& rhs) {
-    write(rhs.read());
+    write_u16(rhs.read_u16());
     return *this;
 }
\ No newline at end of file
@@ -55,8 +55,11 @@ public:
     /** Create a servo object connected to the specified PwmOut pin
      *
      * @param pin PwmOut pin to connect to 
+     * @param center Move to the centre position straight away. If false no
+     *        pulses are sent, and the servo stays where it is, until the
+     *        first write.
      */
-    Servo(PinName pin);
+    Servo(PinName pin, bool center = true);
     
     /** Set the servo position, normalised to it's full range
      *
@@ -69,6 +72,20 @@ public:
      * @param returns A normalised number 0.0-1.0  representing the full range.
      */
     inline float read() {
+        return _p * (1.0f / 65535);
+    }
+    
+    /** Set the servo position without any floating point math
+     *
+     * @param value A number 0-65535 to represent the full range.
+     */
+    void write_u16(unsigned short value);
+    
+    /**  Read the servo motors current position
+     *
+     * @param returns A number 0-65535 representing the full range.
+     */
+    inline unsigned short read_u16() {
         return _p;
     }
     
@@ -78,7 +95,56 @@ public:
      */
     void position(float degrees);
     
+    /** Describe how fast the servo moves, so where the horn actually is can
+     * be estimated. Until this is called the horn is assumed to get wherever
+     * it is sent straight away.
+     *
+     * The horn is modelled as moving at a constant speed towards the last
+     * position written, then taking the settle time to come to rest. The
+     * first write after power up assumes it starts from the far end.
+     *
+     * @param speed Rated speed with no load, in full range per second
+     * @param load Fraction of the rated speed the servo manages in use, 0.0-1.0
+     * @param settle Time to come to rest once there, in seconds
+     */
+    void motion(float speed, float load = 1.0f, float settle = 0.0f);
+    
+    /** Estimate where the horn is now, from the motion model
+     *
+     * @param returns A normalised number 0.0-1.0 representing the full range.
+     */
+    inline float estimate() {
+        return estimate_u16() * (1.0f / 65535);
+    }
+    
+    /** Estimate where the horn is now, from the motion model
+     *
+     * @param returns A number 0-65535 representing the full range.
+     */
+    unsigned short estimate_u16();
+    
+    /** Bring the motion model up to date, ending the motion once the horn
+     * should be at rest. The model times moves with us_ticker_read(), which
+     * wraps every 71 minutes, so a servo that may sit idle longer than that
+     * needs this, estimate_u16() or settled() called on it now and then.
+     */
+    void update() const;
+    
+    /** Time until the horn should be at rest on the last position written.
+     * Brings the model up to date as update() does, nothing else changes.
+     *
+     * @param returns The time in seconds, 0 if it is already there.
+     */
+    float settleTime() const;
+    
+    inline bool settled() const {
+        return settleTime() == 0;
+    }
+    
     /**  Allows calibration of the range and angles for a particular servo
+     *
+     * The float parameters are converted to integer pulsewidths here, so
+     * write_u16() never has to touch floating point.
      *
      * @param range Pulsewidth range from center (1.5ms) to maximum/minimum position in seconds
      * @param degrees Angle from centre to maximum/minimum position in degrees
@@ -93,10 +159,28 @@ public:
     }
 
 protected:
+    friend class ServoGroup;
+    
+    int pulsewidth(unsigned short value);
+    void track(unsigned short value);
+    void update(uint32_t now) const;
+    unsigned int travelTime(unsigned short from, unsigned short to) const;
+    
     PwmOut _pwm;
-    float _range;
-    float _degrees;
-    float _p;
+    PinName _pin;
+    int _minPulse;          // pulsewidth at position 0, in us
+    unsigned int _span;     // pulsewidth from position 0 to 65535, in us
+    float _perDegree;       // position steps per degree
+    unsigned short _p;
+    
+    // Motion model, the horn moves from _from towards _p starting at _start
+    unsigned int _rate;     // position steps per second, 0 for no model
+    unsigned int _settle;   // us
+    // Ending a motion doesn't change where the horn is, so reads can do it
+    mutable unsigned short _from;
+    uint32_t _start;
+    bool _known;            // written to since power up
+    mutable bool _moving;   // not at rest yet
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ServoGroup.h"
+
+#if defined(SERVO_GROUP_LATCH)
+
+/* Finds the PWM1 channel (1-6) driven by a pin, or 0 if it isn't a PWM pin
+ */
+static int pwmChannel(PinName pin) {
+    switch (pin) {
+    case P1_18: case P2_0: return 1;
+    case P1_20: case P2_1: case P3_25: return 2;
+    case P1_21: case P2_2: case P3_26: return 3;
+    case P1_23: case P2_3: return 4;
+    case P1_24: case P2_4: return 5;
+    case P1_26: case P2_5: return 6;
+    default: return 0;
+    }
+}
+
+/* MR1-MR3 and MR4-MR6 are not next to each other in the register map
+ */
+static PwmMatchRegister* matchRegister(int channel) {
+    if (channel <= 3) {
+        return &LPC_PWM1->MR1 + (channel - 1);
+    }
+    return &LPC_PWM1->MR4 + (channel - 4);
+}
+
+#endif
+
+ServoGroup::ServoGroup() {
+    _count = 0;
+    _dirty = 0;
+#if defined(SERVO_GROUP_LATCH)
+    // PwmOut runs PWM1 from PCLK = CCLK / 4
+    _ticksPerUs = SystemCoreClock / 4000000;
+#endif
+}
+
+int ServoGroup::add(Servo& servo) {
+    if (_count >= SERVO_GROUP_MAX) return -1;
+#if defined(SERVO_GROUP_LATCH)
+    int channel = pwmChannel(servo._pin);
+    if (channel == 0) return -1;
+    _match[_count] = matchRegister(channel);
+    _latch[_count] = 1 << channel;
+#endif
+    _servos[_count] = &servo;
+    _staged[_count] = servo.read_u16();
+    return _count++;
+}
+
+void ServoGroup::stage(int index, float percent) {
+    if (percent < 0.0f) percent = 0.0f;
+    else if (percent > 1.0f) percent = 1.0f;
+    stage_u16(index, (unsigned short)(percent * 65535 + 0.5f));
+}
+
+void ServoGroup::stage(Servo& servo, float percent) {
+    stage(indexOf(servo), percent);
+}
+
+void ServoGroup::stage_u16(int index, unsigned short value) {
+    if ((index < 0) || (index >= _count)) return;
+    _staged[index] = value;
+    _dirty |= 1 << index;
+}
+
+void ServoGroup::stage_u16(Servo& servo, unsigned short value) {
+    stage_u16(indexOf(servo), value);
+}
+
+void ServoGroup::commit() {
+    if (_dirty == 0) return;
+#if defined(SERVO_GROUP_LATCH)
+    uint32_t latch = 0;
+    for (int i = 0; i < _count; i++) {
+        if (!(_dirty & (1 << i))) continue;
+        *_match[i] = _servos[i]->pulsewidth(_staged[i]) * _ticksPerUs;
+        _servos[i]->track(_staged[i]);
+        latch |= _latch[i];
+    }
+    // The new match values are all picked up at the start of the next period
+    LPC_PWM1->LER |= latch;
+#else
+    for (int i = 0; i < _count; i++) {
+        if (_dirty & (1 << i)) {
+            _servos[i]->write_u16(_staged[i]);
+        }
+    }
+#endif
+    _dirty = 0;
+}
+
+int ServoGroup::indexOf(Servo& servo) {
+    for (int i = 0; i < _count; i++) {
+        if (_servos[i] == &servo) return i;
+    }
+    return -1;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SORO_SERVOGROUP_H
+#define SORO_SERVOGROUP_H
+
+#include "mbed.h"
+#include "Servo.h"
+
+// PWM1 has six match channels, so that's as many servos as can share a latch
+#define SERVO_GROUP_MAX 6
+
+// Host tests swap the PWM1 registers for a mock, see host/MockPwm1.h
+#if defined(SERVO_GROUP_MOCK_PWM1)
+#include "MockPwm1.h"
+#define SERVO_GROUP_LATCH
+#elif defined(TARGET_LPC1768)
+typedef volatile uint32_t PwmMatchRegister;
+#define SERVO_GROUP_LATCH
+#endif
+
+/** A set of servos that are updated together
+ *
+ * New positions are staged for any number of members and then written by
+ * commit(). On the LPC1768 commit() loads every staged match register and
+ * sets all of their latch enable bits with one write, so the new pulsewidths
+ * all start in the same PWM period. Unlike PwmOut it doesn't restart the PWM
+ * counter on every write either. On other targets commit() falls back to
+ * writing each servo in turn.
+ *
+ * Example:
+ * @code
+ * ServoGroup wheels;
+ * wheels.add(left);
+ * wheels.add(right);
+ *
+ * wheels.stage(left, 0.75);
+ * wheels.stage(right, 0.25);
+ * wheels.commit();
+ * @endcode
+ */
+class ServoGroup {
+
+public:
+    ServoGroup();
+
+    /** Add a servo to the group
+     *
+     * @param servo Servo on one of the PWM1 pins
+     * @returns Index of the servo in the group, or -1 if it can't be added
+     */
+    int add(Servo& servo);
+
+    /** Stage a new position for a member, normalised to its full range */
+    void stage(int index, float percent);
+    void stage(Servo& servo, float percent);
+
+    /** Stage a new position for a member, 0-65535 for its full range */
+    void stage_u16(int index, unsigned short value);
+    void stage_u16(Servo& servo, unsigned short value);
+
+    /** Write every staged position at once */
+    void commit();
+
+    inline int count() {
+        return _count;
+    }
+
+    inline Servo& operator[](int index) {
+        return *_servos[index];
+    }
+
+protected:
+    int indexOf(Servo& servo);
+
+    Servo* _servos[SERVO_GROUP_MAX];
+    unsigned short _staged[SERVO_GROUP_MAX];
+    int _count;
+    unsigned int _dirty;
+#if defined(SERVO_GROUP_LATCH)
+    PwmMatchRegister* _match[SERVO_GROUP_MAX];
+    uint32_t _latch[SERVO_GROUP_MAX];
+    uint32_t _ticksPerUs;
+#endif
+};
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SlewLimiter.h"
+
+SlewLimiter::SlewLimiter(ServoGroup& group, unsigned int rate, unsigned int accelTime, unsigned int stopTime) : _group(group) {
+    _rate = rate;
+    _stopStep = stepFor(stopTime);
+    _halting = false;
+    for (int i = 0; i < SERVO_GROUP_MAX; i++) {
+        _step[i] = stepFor(accelTime);
+        _current[i] = SLEW_LIMITER_CENTER;
+        _target[i] = SLEW_LIMITER_CENTER;
+    }
+}
+
+/* Converts a center to end time into counts per tick, never less than one
+ * so every member eventually gets where it's going
+ */
+unsigned int SlewLimiter::stepFor(unsigned int time) {
+    unsigned int ticks = time * _rate / 1000;
+    if (ticks == 0) return SLEW_LIMITER_CENTER;
+    return (SLEW_LIMITER_CENTER + ticks - 1) / ticks;
+}
+
+void SlewLimiter::setLimit(int index, unsigned int accelTime) {
+    if ((index < 0) || (index >= SERVO_GROUP_MAX)) return;
+    _step[index] = stepFor(accelTime);
+}
+
+void SlewLimiter::start() {
+    for (int i = 0; i < _group.count(); i++) {
+        _current[i] = _group[i].read_u16();
+        _target[i] = _current[i];
+    }
+    _ticker.attach_us(this, &SlewLimiter::tick, 1000000 / _rate);
+}
+
+void SlewLimiter::setTarget(int index, unsigned short value) {
+    if ((index < 0) || (index >= _group.count())) return;
+    _target[index] = value;
+    _halting = false;
+}
+
+void SlewLimiter::setTarget(Servo& servo, unsigned short value) {
+    for (int i = 0; i < _group.count(); i++) {
+        if (&_group[i] == &servo) {
+            setTarget(i, value);
+            return;
+        }
+    }
+}
+
+void SlewLimiter::halt() {
+    // Targets first, so a tick in between never ramps the old ones at the stop limit
+    for (int i = 0; i < _group.count(); i++) {
+        _target[i] = SLEW_LIMITER_CENTER;
+    }
+    _halting = true;
+}
+
+void SlewLimiter::stop() {
+    // The ticker can't run in between, so it never commits a partly staged group
+    __disable_irq();
+    for (int i = 0; i < _group.count(); i++) {
+        _target[i] = SLEW_LIMITER_CENTER;
+        _current[i] = SLEW_LIMITER_CENTER;
+        _group.stage_u16(i, SLEW_LIMITER_CENTER);
+    }
+    _group.commit();
+    _halting = true;
+    __enable_irq();
+}
+
+bool SlewLimiter::settled() {
+    for (int i = 0; i < _group.count(); i++) {
+        if (_current[i] != _target[i]) return false;
+    }
+    return true;
+}
+
+void SlewLimiter::tick() {
+    bool halting = _halting;
+    for (int i = 0; i < _group.count(); i++) {
+        int current = _current[i];
+        int target = _target[i];
+        if (current == target) continue;
+        
+        int step = _step[i];
+        if (halting && (_stopStep > _step[i])) step = _stopStep;
+        if (target > current + step) current += step;
+        else if (target < current - step) current -= step;
+        else current = target;
+        
+        _current[i] = current;
+        _group.stage_u16(i, current);
+    }
+    _group.commit();
+}
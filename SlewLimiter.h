@@ -0,0 +1,104 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_SLEWLIMITER_H
+#define SORO_SLEWLIMITER_H
+
+#include "mbed.h"
+#include "ServoGroup.h"
+
+// Position every member ramps to on halt(), which is stopped for a wheel
+#define SLEW_LIMITER_CENTER 32768
+
+/** Ramps the members of a ServoGroup towards their targets at a limited rate
+ *
+ * A Ticker moves every member a bounded step towards its target and commits
+ * the group, so the outputs change at the ramp rate no matter how often new
+ * targets arrive. Each member has its own acceleration limit, given as the
+ * time to go from center to either end. halt() sends every member to center
+ * with a separate, usually faster, limit for failsafe stops, and stop()
+ * puts them there at once.
+ *
+ * Once started the limiter owns the group. Nothing else should stage or
+ * commit to it.
+ *
+ * Example:
+ * @code
+ * SlewLimiter ramp(wheels, 500, 400, 150);
+ *
+ * int main() {
+ *     ramp.start();
+ *     ramp.setTarget(left, 65535);    // full speed in 400ms
+ *     // ...
+ *     ramp.halt();                    // stopped in 150ms at most
+ * }
+ * @endcode
+ */
+class SlewLimiter {
+
+public:
+    /** Create a stopped limiter
+     *
+     * @param group Servos to ramp, added to the group before start()
+     * @param rate Ramp steps per second
+     * @param accelTime Default time for a member to go from center to either end, in ms
+     * @param stopTime Time for halt() to bring a member from either end to center, in ms
+     */
+    SlewLimiter(ServoGroup& group, unsigned int rate, unsigned int accelTime, unsigned int stopTime);
+
+    /** Change the acceleration limit of one member
+     *
+     * @param index Index of the member in the group
+     * @param accelTime Time to go from center to either end, in ms
+     */
+    void setLimit(int index, unsigned int accelTime);
+
+    /** Start ramping from wherever the members are now */
+    void start();
+
+    /** Set where a member should ramp to, 0-65535 for its full range.
+     * Cancels a halt in progress.
+     */
+    void setTarget(int index, unsigned short value);
+    void setTarget(Servo& servo, unsigned short value);
+
+    /** Ramp every member to center at the stop limit */
+    void halt();
+
+    /** Put every member at center now and commit the group, without
+     * ramping. Safe to call from any thread.
+     */
+    void stop();
+
+    /** Whether every member has reached its target */
+    bool settled();
+
+protected:
+    void tick();
+    unsigned int stepFor(unsigned int time);
+
+    ServoGroup& _group;
+    Ticker _ticker;
+    unsigned int _rate;                     // Hz
+    unsigned int _stopStep;                 // counts per tick
+    volatile bool _halting;
+    unsigned int _step[SERVO_GROUP_MAX];    // counts per tick
+    unsigned short _current[SERVO_GROUP_MAX];
+    volatile unsigned short _target[SERVO_GROUP_MAX];
+};
+
+#endif
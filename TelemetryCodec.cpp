@@ -0,0 +1,351 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "TelemetryCodec.h"
+
+#include <cstring>
+
+static inline bool isDigit(char c) {
+    return (c >= '0') && (c <= '9');
+}
+
+static inline unsigned int zigzag(int value) {
+    return ((unsigned int)value << 1) ^ (unsigned int)(value >> 31);
+}
+
+static inline int unzigzag(unsigned int value) {
+    return (int)(value >> 1) ^ -(int)(value & 1);
+}
+
+/* Number of digits a value is written with, without leading zeros
+ */
+static int widthOf(int value) {
+    int width = 1;
+    while (value >= 10) {
+        value /= 10;
+        width++;
+    }
+    return width;
+}
+
+/* Reads a number of up to TELEMETRY_MAX_DIGITS digits starting at in[i]
+ *
+ * @returns The index just past it
+ */
+static int readNumber(const char* in, int length, int i, int& value) {
+    int start = i;
+    value = 0;
+    while ((i < length) && (i - start < TELEMETRY_MAX_DIGITS) && isDigit(in[i])) {
+        value = value * 10 + (in[i++] - '0');
+    }
+    return i;
+}
+
+/* Finds the end of the text starting at in[i], at the next digit
+ */
+static int skipText(const char* in, int length, int i) {
+    while ((i < length) && !isDigit(in[i])) {
+        i++;
+    }
+    return i;
+}
+
+TelemetryCodec::TelemetryCodec() {
+    reset();
+}
+
+void TelemetryCodec::reset() {
+    memset(&_state, 0, sizeof(_state));
+}
+
+int TelemetryCodec::putVarint(char* out, unsigned int value) {
+    int end = 0;
+    while (value >= 0x80) {
+        out[end++] = (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out[end++] = (char)value;
+    return end;
+}
+
+int TelemetryCodec::getVarint(const char* in, int length, unsigned int& value) {
+    value = 0;
+    for (int i = 0; (i < length) && (i < 5); i++) {
+        unsigned char byte = (unsigned char)in[i];
+        value |= (unsigned int)(byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) return i + 1;
+    }
+    return -1;
+}
+
+/* Records a record as if it had been encoded, so a record sent
+ * raw still primes the next one
+ */
+void TelemetryCodec::learn(const char* record, int length) {
+    int field = 0;
+    int i = 0;
+    while (i < length) {
+        int start = i;
+        i = skipText(record, length, i);
+        for (int j = start; j < i; j += TELEMETRY_MAX_RUN) {
+            int run = (i - j < TELEMETRY_MAX_RUN) ? i - j : TELEMETRY_MAX_RUN;
+            if (findWord(&record[j], run) < 0) addWord(&record[j], run);
+        }
+        if (i == length) break;
+        
+        int digits = i;
+        int value;
+        i = readNumber(record, length, i, value);
+        if (field < TELEMETRY_FIELDS) {
+            setText(field, &record[start], digits - start);
+            _state.zeros[field] = (i - digits) - widthOf(value);
+            _state.fields[field] = value;
+        }
+        field++;
+    }
+}
+
+bool TelemetryCodec::sameText(int field, const char* text, int length) {
+    return (_state.textLengths[field] == length) && (memcmp(_state.texts[field], text, length) == 0);
+}
+
+void TelemetryCodec::setText(int field, const char* text, int length) {
+    if (length > TELEMETRY_WORD_SIZE) {
+        _state.textLengths[field] = TELEMETRY_UNKNOWN_TEXT;
+        return;
+    }
+    memcpy(_state.texts[field], text, length);
+    _state.textLengths[field] = length;
+}
+
+int TelemetryCodec::findWord(const char* text, int length) {
+    for (int i = 0; i < TELEMETRY_WORDS; i++) {
+        if ((_state.wordLengths[i] == length) && (memcmp(_state.words[i], text, length) == 0)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Words replace each other in turn, which is as good as least recently
+ * used for records that repeat the same labels in the same order
+ */
+void TelemetryCodec::addWord(const char* text, int length) {
+    if (length > TELEMETRY_WORD_SIZE) return;
+    memcpy(_state.words[_state.nextWord], text, length);
+    _state.wordLengths[_state.nextWord] = length;
+    _state.nextWord = (_state.nextWord + 1) % TELEMETRY_WORDS;
+}
+
+int TelemetryEncoder::encode(const char* in, int length, char* out) {
+    _saved = _state;
+    int field = 0;
+    int end = 0;
+    int i = 0;
+    
+    // Stops as soon as the record isn't getting any smaller
+    while ((end >= 0) && (i < length)) {
+        int start = i;
+        i = skipText(in, length, i);
+        bool remembered = (i < length) && (field < TELEMETRY_FIELDS);
+        
+        // The text before a remembered field is left out if it hasn't changed
+        if (!remembered || !sameText(field, &in[start], i - start)) {
+            if (i > start) {
+                end = encodeText(&in[start], i - start, out, end, length);
+            }
+            else if (remembered && (end + 1 < length)) {
+                out[end++] = (char)TELEMETRY_TAG_TEXT;
+            }
+            else if (remembered) {
+                end = -1;
+            }
+        }
+        if ((end < 0) || (i == length)) break;
+        
+        int digits = i;
+        int value;
+        i = readNumber(in, length, i, value);
+        int zeros = (i - digits) - widthOf(value);
+        int previous = 0;
+        
+        // Zeros tag, number tag and varint
+        char coded[7];
+        int size = 0;
+        if (remembered) {
+            if (zeros != _state.zeros[field]) {
+                coded[size++] = (char)(TELEMETRY_TAG_ZEROS | zeros);
+            }
+            previous = _state.fields[field];
+            setText(field, &in[start], digits - start);
+            _state.zeros[field] = zeros;
+            _state.fields[field] = value;
+        }
+        else if (zeros > 0) {
+            coded[size++] = (char)(TELEMETRY_TAG_ZEROS | zeros);
+        }
+        field++;
+        
+        unsigned int delta = zigzag(value - previous);
+        if (delta < TELEMETRY_TAG_VARINT) {
+            coded[size++] = (char)delta;
+        }
+        else {
+            coded[size++] = (char)TELEMETRY_TAG_VARINT;
+            size += putVarint(&coded[size], delta - TELEMETRY_TAG_VARINT);
+        }
+        if (end + size >= length) {
+            end = -1;
+            break;
+        }
+        memcpy(&out[end], coded, size);
+        end += size;
+    }
+    if (end >= 0) {
+        return end;
+    }
+    
+    // Not worth it, but the state still moves on as the decoder's will
+    _state = _saved;
+    learn(in, length);
+    return encodeRaw(in, length, out);
+}
+
+/* Appends text as word and text tokens
+ *
+ * @returns The new end of out, or -1 if it would reach limit
+ */
+int TelemetryEncoder::encodeText(const char* in, int length, char* out, int end, int limit) {
+    for (int i = 0; i < length; i += TELEMETRY_MAX_RUN) {
+        int run = (length - i < TELEMETRY_MAX_RUN) ? length - i : TELEMETRY_MAX_RUN;
+        int word = findWord(&in[i], run);
+        if (word >= 0) {
+            if (end + 1 >= limit) return -1;
+            out[end++] = (char)(TELEMETRY_TAG_WORD | word);
+            continue;
+        }
+        if (end + 1 + run >= limit) return -1;
+        out[end++] = (char)(TELEMETRY_TAG_TEXT | run);
+        memcpy(&out[end], &in[i], run);
+        end += run;
+        addWord(&in[i], run);
+    }
+    return end;
+}
+
+int TelemetryEncoder::encodeRaw(const char* in, int length, char* out) {
+    int end = 0;
+    for (int i = 0; i < length; i += TELEMETRY_MAX_RUN) {
+        int run = length - i;
+        if (run > TELEMETRY_MAX_RUN) run = TELEMETRY_MAX_RUN;
+        out[end++] = (char)(TELEMETRY_TAG_RAW | run);
+        memcpy(&out[end], &in[i], run);
+        end += run;
+    }
+    return end;
+}
+
+int TelemetryDecoder::decode(const char* in, int length, char* out, int size) {
+    int field = 0;
+    int zeros = -1;             // none given for the next number
+    bool explicitText = false;  // text given for the next number
+    int textStart = 0;
+    int end = 0;
+    int i = 0;
+    bool raw = (length > 0) && (((unsigned char)in[0] & TELEMETRY_TAG_RAW) == TELEMETRY_TAG_RAW);
+    
+    while (i < length) {
+        unsigned int tag = (unsigned char)in[i++];
+        if (raw != ((tag & TELEMETRY_TAG_RAW) == TELEMETRY_TAG_RAW)) return -1;
+        
+        if (tag < TELEMETRY_TAG_TEXT) {
+            unsigned int delta = tag;
+            if (tag == TELEMETRY_TAG_VARINT) {
+                unsigned int rest;
+                int used = getVarint(&in[i], length - i, rest);
+                if (used < 0) return -1;
+                i += used;
+                delta += rest;
+            }
+            int value = unzigzag(delta);
+            
+            if (field < TELEMETRY_FIELDS) {
+                if (explicitText) {
+                    setText(field, &out[textStart], end - textStart);
+                }
+                else {
+                    int run = _state.textLengths[field];
+                    if ((run == TELEMETRY_UNKNOWN_TEXT) || (end + run > size)) return -1;
+                    memcpy(&out[end], _state.texts[field], run);
+                    end += run;
+                }
+                if (zeros < 0) zeros = _state.zeros[field];
+                value += _state.fields[field];
+                _state.zeros[field] = zeros;
+                _state.fields[field] = value;
+            }
+            else if (zeros < 0) {
+                zeros = 0;
+            }
+            field++;
+            
+            int width = widthOf(value);
+            if ((value < 0) || (zeros + width > TELEMETRY_MAX_DIGITS) || (end + zeros + width > size)) return -1;
+            while (zeros > 0) {
+                out[end++] = '0';
+                zeros--;
+            }
+            for (int j = width - 1; j >= 0; j--) {
+                out[end + j] = '0' + value % 10;
+                value /= 10;
+            }
+            end += width;
+            
+            zeros = -1;
+            explicitText = false;
+            textStart = end;
+        }
+        else if ((tag >= TELEMETRY_TAG_ZEROS) && (tag < TELEMETRY_TAG_RAW)) {
+            zeros = tag - TELEMETRY_TAG_ZEROS;
+            if (zeros >= TELEMETRY_MAX_DIGITS) return -1;
+        }
+        else {
+            int run = tag & TELEMETRY_MAX_RUN;
+            const char* text = &in[i];
+            if ((tag & TELEMETRY_TAG_RAW) == TELEMETRY_TAG_WORD) {
+                if (run >= TELEMETRY_WORDS) return -1;
+                text = _state.words[run];
+                run = _state.wordLengths[run];
+            }
+            else {
+                if (i + run > length) return -1;
+                i += run;
+            }
+            if (end + run > size) return -1;
+            memcpy(&out[end], text, run);
+            end += run;
+            explicitText = true;
+            if (((tag & TELEMETRY_TAG_RAW) == TELEMETRY_TAG_TEXT) && (run > 0)) {
+                addWord(text, run);
+            }
+        }
+    }
+    if (raw) {
+        learn(out, end);
+    }
+    return end;
+}
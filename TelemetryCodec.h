@@ -0,0 +1,155 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_TELEMETRYCODEC_H
+#define SORO_TELEMETRYCODEC_H
+
+// Numbers per record whose last value is remembered, later ones are sent whole
+#define TELEMETRY_FIELDS 16
+
+// Text tokens remembered, and the longest one that is
+#define TELEMETRY_WORDS 16
+#define TELEMETRY_WORD_SIZE 15
+
+// Longest run of digits read as one number, so it fits in an int
+#define TELEMETRY_MAX_DIGITS 9
+
+// Longest text run in one token
+#define TELEMETRY_MAX_RUN 63
+
+// Length of a field's text when it was too long to remember
+#define TELEMETRY_UNKNOWN_TEXT 0xFF
+
+// Largest possible encoded size of a record
+#define TELEMETRY_MAX_ENCODED_SIZE(length) ((length) + ((length) + TELEMETRY_MAX_RUN - 1) / TELEMETRY_MAX_RUN)
+
+// Token tags. A number's zigzagged delta is the tag itself if it is below
+// TELEMETRY_TAG_VARINT, otherwise the rest follows as a varint. Text and
+// raw tags carry their length, word tags their index, and zeros tags the
+// number of leading zeros on the number after them. A text tag with no
+// text says there is none before the next number.
+#define TELEMETRY_TAG_VARINT 0x3F
+#define TELEMETRY_TAG_TEXT 0x40
+#define TELEMETRY_TAG_WORD 0x80
+#define TELEMETRY_TAG_ZEROS 0x90
+#define TELEMETRY_TAG_RAW 0xC0
+
+/** Compression of text telemetry records made of numbers and labels
+ *
+ * A record such as "temp=23.1,hum=48" is split into numbers (runs of
+ * digits) and the text before each of them. Each number is sent as the
+ * difference from the same field of the record before, zigzag and varint
+ * coded, so a slowly changing reading takes one byte. The text before a
+ * field and its leading zeros are only sent when they differ from the
+ * record before, as the index of a small dictionary of recent tokens if it
+ * is in there. A record that wouldn't get any smaller is sent as it is.
+ * Decoding gives back exactly the bytes that were encoded. A raw record
+ * still updates the fields and words, since the decoder can split it up the
+ * same way.
+ *
+ * The encoder and decoder keep the same state, so they must see the same
+ * records in the same order since they were both last reset. SerialForwarder
+ * carries that state from one datagram to the next, and only resets it for a
+ * key datagram, which it flags with SERIAL_RECORDS_KEY and sends at least
+ * every SERIAL_FORWARD_KEY_INTERVAL_MS. A key datagram decodes on its own.
+ * The datagrams after it only decode if none in between were lost, so a
+ * lost datagram costs the records in it and every record until the next key,
+ * up to about a second of telemetry. The receiver spots the loss from the
+ * datagram sequence numbers, as tools/telemetry_decode does, and waits for
+ * the next key.
+ *
+ * Neither needs mbed.h, so the decoder builds anywhere.
+ */
+class TelemetryCodec {
+
+public:
+    TelemetryCodec();
+
+    /** Forget every field and word */
+    void reset();
+
+    /** Write an unsigned varint, 7 bits per byte, low bits first
+     *
+     * @returns Number of bytes written, at most 5
+     */
+    static int putVarint(char* out, unsigned int value);
+
+    /** Read an unsigned varint
+     *
+     * @returns Number of bytes read, or -1 if it runs past the end
+     */
+    static int getVarint(const char* in, int length, unsigned int& value);
+
+protected:
+    struct State {
+        int fields[TELEMETRY_FIELDS];
+        unsigned char zeros[TELEMETRY_FIELDS];
+        char texts[TELEMETRY_FIELDS][TELEMETRY_WORD_SIZE];
+        unsigned char textLengths[TELEMETRY_FIELDS];     // TELEMETRY_UNKNOWN_TEXT if too long
+        char words[TELEMETRY_WORDS][TELEMETRY_WORD_SIZE];
+        unsigned char wordLengths[TELEMETRY_WORDS];
+        int nextWord;
+    };
+
+    void learn(const char* record, int length);
+    bool sameText(int field, const char* text, int length);
+    void setText(int field, const char* text, int length);
+    int findWord(const char* text, int length);
+    void addWord(const char* text, int length);
+
+    State _state;
+};
+
+/** Encodes records on the sender
+ *
+ * Example:
+ * @code
+ * TelemetryEncoder encoder;
+ * char out[TELEMETRY_MAX_ENCODED_SIZE(sizeof(record))];
+ * int len = encoder.encode(record, recordLength, out);
+ * @endcode
+ */
+class TelemetryEncoder : public TelemetryCodec {
+
+public:
+    /** Encode one record
+     *
+     * @param out Holds at least TELEMETRY_MAX_ENCODED_SIZE(length) bytes
+     * @returns The encoded length
+     */
+    int encode(const char* in, int length, char* out);
+
+protected:
+    int encodeText(const char* in, int length, char* out, int end, int limit);
+    int encodeRaw(const char* in, int length, char* out);
+
+    State _saved;               // state from before a record, in case it is sent raw
+};
+
+/** Decodes records on the receiver */
+class TelemetryDecoder : public TelemetryCodec {
+
+public:
+    /** Decode one record
+     *
+     * @param size Space in out
+     * @returns The decoded length, or -1 if the record is malformed or doesn't fit
+     */
+    int decode(const char* in, int length, char* out, int size);
+};
+
+#endif
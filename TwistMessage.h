@@ -0,0 +1,74 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_TWISTMESSAGE_H
+#define SORO_TWISTMESSAGE_H
+
+/* Drive command giving the rover's velocity instead of each wheel's. Like the
+ * diagnostic types it is kept clear of the MbedMessageType values in the soro
+ * repository, and below MBED_MESSAGE_TRACED so it can be traced.
+ */
+#define MBED_MESSAGE_TWIST 0x30
+
+// Curvature limit which lets the angular velocity match the linear one
+#define TWIST_CURVATURE_ONE 16
+
+/** Packing of twist messages
+ *
+ * A twist is the type byte, the linear velocity and the angular velocity,
+ * each a signed byte from -127 to 127 for full speed backwards to forwards,
+ * or clockwise to counterclockwise. A positive angular velocity turns left.
+ *
+ * An optional fourth byte limits the curvature of the path: the angular
+ * velocity is cut down to at most the linear velocity times the limit over
+ * TWIST_CURVATURE_ONE, so a limit also stops turns in place. Without it,
+ * or with 0, turning isn't limited.
+ */
+namespace TwistMessage {
+
+    const int RequiredSize = 3;
+    const int RequiredSize_Curvature = 4;
+
+    inline int getLinear(const char* message) {
+        return (signed char)message[1];
+    }
+
+    inline int getAngular(const char* message) {
+        return (signed char)message[2];
+    }
+
+    /** The curvature limit, or 0 if the message has none */
+    inline unsigned int getCurvature(const char* message, int length) {
+        if (length < RequiredSize_Curvature) return 0;
+        return (unsigned char)message[3];
+    }
+
+    /** Pack a twist, leaving out the curvature limit if it is 0
+     *
+     * @returns The length of the message
+     */
+    inline int setTwist(char* message, int linear, int angular, unsigned int curvature = 0) {
+        message[0] = (char)MBED_MESSAGE_TWIST;
+        message[1] = (signed char)linear;
+        message[2] = (signed char)angular;
+        if (curvature == 0) return RequiredSize;
+        message[3] = (char)curvature;
+        return RequiredSize_Curvature;
+    }
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "TwistMixer.h"
+#include "TwistMessage.h"
+
+TwistMixer::TwistMixer() {
+    _linear = 0;
+    _angular = 0;
+    for (int i = 0; i < WheelCount; i++) {
+        _trim[i] = TWIST_MIXER_UNITY_TRIM;
+    }
+}
+
+void TwistMixer::setTwist(int linear, int angular, unsigned int curvature) {
+    if (curvature != 0) {
+        int limit = (linear < 0 ? -linear : linear) * (int)curvature / TWIST_CURVATURE_ONE;
+        if (angular > limit) angular = limit;
+        else if (angular < -limit) angular = -limit;
+    }
+    _linear = linear;
+    _angular = angular;
+}
+
+void TwistMixer::setTrim(Wheel wheel, unsigned int gain) {
+    _trim[wheel] = gain;
+}
+
+void TwistMixer::mix(int* speeds) const {
+    int left = _linear - _angular;
+    int right = _linear + _angular;
+    
+    // Velocities are out of 127 from here on, up to 254 before scaling
+    int largest = 127;
+    for (int i = 0; i < WheelCount; i++) {
+        int speed = (i < RightOuter) ? left : right;
+        speed = speed * (int)_trim[i] / TWIST_MIXER_UNITY_TRIM;
+        speeds[i] = speed;
+        
+        int magnitude = speed < 0 ? -speed : speed;
+        if (magnitude > largest) largest = magnitude;
+    }
+    
+    // Scaling every wheel by the same amount keeps the ratio between the
+    // sides, and so the curvature of the path
+    for (int i = 0; i < WheelCount; i++) {
+        speeds[i] = speeds[i] * TWIST_MIXER_FULL_SPEED / largest;
+    }
+}
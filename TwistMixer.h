@@ -0,0 +1,83 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_TWISTMIXER_H
+#define SORO_TWISTMIXER_H
+
+#include "mbed.h"
+
+// Trim gain which leaves a wheel's speed as it is
+#define TWIST_MIXER_UNITY_TRIM 256
+
+// Largest wheel speed mix() puts out, either way
+#define TWIST_MIXER_FULL_SPEED 32767
+
+/** Mixes a linear and angular velocity into speeds for a skid steered rover
+ *
+ * Both wheels on a side get the same speed: the linear velocity less the
+ * angular velocity on the left, plus it on the right. Each wheel then has
+ * its own trim gain applied. If any wheel would need more than full speed,
+ * every wheel is scaled down by the same amount so the rover still follows
+ * the commanded path, just slower. Everything is done in integer math.
+ *
+ * Example:
+ * @code
+ * TwistMixer mixer;
+ * int speeds[TwistMixer::WheelCount];
+ *
+ * mixer.setTwist(100, 20, 0);
+ * mixer.mix(speeds);
+ * @endcode
+ */
+class TwistMixer {
+
+public:
+    enum Wheel {
+        LeftOuter, LeftMiddle, RightOuter, RightMiddle, WheelCount
+    };
+
+    /** Create a mixer which is stopped, with no trim */
+    TwistMixer();
+
+    /** Set the velocity to mix, in the units of a TwistMessage
+     *
+     * @param linear Forward velocity, -127 to 127
+     * @param angular Counterclockwise velocity, -127 to 127
+     * @param curvature Curvature limit in 1/TWIST_CURVATURE_ONE, or 0 for none
+     */
+    void setTwist(int linear, int angular, unsigned int curvature);
+
+    /** Scale one wheel's speed to make up for differences between motors
+     *
+     * @param gain Gain in 1/TWIST_MIXER_UNITY_TRIM
+     */
+    void setTrim(Wheel wheel, unsigned int gain);
+
+    /** Work out the speed for every wheel
+     *
+     * @param speeds Receives WheelCount speeds, from -TWIST_MIXER_FULL_SPEED
+     * to TWIST_MIXER_FULL_SPEED. The right side is not mirrored.
+     */
+    void mix(int* speeds) const;
+
+protected:
+    int _linear;
+    int _angular;
+    unsigned int _trim[WheelCount];
+};
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ArmKinematics.h"
+#include "ArmLimits.h"
+
+// Keep the wrist this far inside full reach, like the old float version did
+#define REACH_MARGIN 10
+#define MAX_REACH (BICEP_LENGTH + FOREARM_LENGTH - REACH_MARGIN)
+#define MIN_REACH ((BICEP_LENGTH > FOREARM_LENGTH ? BICEP_LENGTH - FOREARM_LENGTH : FOREARM_LENGTH - BICEP_LENGTH) + REACH_MARGIN)
+
+/* atan(i / 256) for i = 0-256, in hundredths of a degree
+ */
+static const unsigned short _atanTable[257] = {
+    0, 22, 45, 67, 90, 112, 134, 157, 179, 201, 224, 246,
+    268, 291, 313, 335, 358, 380, 402, 424, 447, 469, 491, 513,
+    536, 558, 580, 602, 624, 646, 668, 690, 713, 735, 757, 779,
+    800, 822, 844, 866, 888, 910, 932, 953, 975, 997, 1019, 1040,
+    1062, 1084, 1105, 1127, 1148, 1170, 1191, 1213, 1234, 1255, 1277, 1298,
+    1319, 1340, 1361, 1383, 1404, 1425, 1446, 1467, 1488, 1508, 1529, 1550,
+    1571, 1592, 1612, 1633, 1653, 1674, 1695, 1715, 1735, 1756, 1776, 1796,
+    1817, 1837, 1857, 1877, 1897, 1917, 1937, 1957, 1977, 1997, 2016, 2036,
+    2056, 2075, 2095, 2114, 2134, 2153, 2172, 2192, 2211, 2230, 2249, 2268,
+    2287, 2306, 2325, 2344, 2363, 2382, 2400, 2419, 2438, 2456, 2475, 2493,
+    2511, 2530, 2548, 2566, 2584, 2603, 2621, 2639, 2657, 2674, 2692, 2710,
+    2728, 2745, 2763, 2780, 2798, 2815, 2833, 2850, 2867, 2885, 2902, 2919,
+    2936, 2953, 2970, 2987, 3003, 3020, 3037, 3053, 3070, 3086, 3103, 3119,
+    3136, 3152, 3168, 3184, 3201, 3217, 3233, 3249, 3264, 3280, 3296, 3312,
+    3327, 3343, 3359, 3374, 3390, 3405, 3420, 3436, 3451, 3466, 3481, 3496,
+    3511, 3526, 3541, 3556, 3571, 3585, 3600, 3615, 3629, 3644, 3658, 3673,
+    3687, 3701, 3716, 3730, 3744, 3758, 3772, 3786, 3800, 3814, 3828, 3841,
+    3855, 3869, 3882, 3896, 3909, 3923, 3936, 3950, 3963, 3976, 3989, 4003,
+    4016, 4029, 4042, 4055, 4067, 4080, 4093, 4106, 4119, 4131, 4144, 4156,
+    4169, 4181, 4194, 4206, 4218, 4231, 4243, 4255, 4267, 4279, 4291, 4303,
+    4315, 4327, 4339, 4351, 4363, 4374, 4386, 4397, 4409, 4421, 4432, 4443,
+    4455, 4466, 4478, 4489, 4500
+};
+
+/* sin(90 * i / 256 degrees) for i = 0-256, in Q15
+ */
+static const unsigned short _sinTable[257] = {
+    0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210,
+    2410, 2611, 2811, 3012, 3212, 3412, 3612, 3811, 4011, 4210, 4410, 4609,
+    4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195, 6393, 6590, 6786, 6983,
+    7179, 7375, 7571, 7767, 7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319,
+    9512, 9704, 9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605,
+    11793, 11980, 12167, 12353, 12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828,
+    14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269, 15446, 15623, 15800, 15976,
+    16151, 16325, 16499, 16673, 16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+    18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000,
+    20159, 20317, 20475, 20631, 20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856,
+    22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027, 23170, 23311, 23452, 23592,
+    23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+    25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198, 26319, 26438, 26556, 26674,
+    26790, 26905, 27019, 27133, 27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001,
+    28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803, 28898, 28992, 29085, 29177,
+    29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+    30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783, 30852, 30919, 30985, 31050,
+    31113, 31176, 31237, 31297, 31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736,
+    31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098, 32137, 32176, 32213, 32250,
+    32285, 32318, 32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+    32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737, 32745, 32752,
+    32757, 32761, 32765, 32766, 32767
+};
+
+/* Linear interpolation into a 257 entry table, index is in Q7 (0-32768)
+ */
+static inline int lookup(const unsigned short* table, uint32_t index) {
+    uint32_t i = index >> 7;
+    if (i >= 256) return table[256];
+    int frac = index & 0x7F;
+    return table[i] + (((table[i + 1] - table[i]) * frac) >> 7);
+}
+
+static uint64_t sqrt64(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+/* acos(num / den), done as atan2(sqrt(den^2 - num^2), num) on the
+ * unscaled values so there is no precision lost near 0 and 180 degrees
+ */
+static int acosRatio(int64_t num, int64_t den) {
+    if (num > den) num = den;
+    else if (num < -den) num = -den;
+    int64_t opposite = (int64_t)sqrt64((uint64_t)(den * den - num * num));
+    // atan2() takes up to 16 bits
+    while ((opposite > 32767) || (num > 32767) || (num < -32767)) {
+        opposite >>= 1;
+        num /= 2;
+    }
+    return ArmKinematics::atan2((int)opposite, (int)num);
+}
+
+int ArmKinematics::atan2(int y, int x) {
+    int ax = x < 0 ? -x : x;
+    int ay = y < 0 ? -y : y;
+    if ((ax == 0) && (ay == 0)) return 0;
+    
+    // Reduce to the first octant so the ratio is always 0-1
+    int angle;
+    if (ay <= ax) {
+        angle = lookup(_atanTable, ((uint32_t)ay << 15) / ax);
+    }
+    else {
+        angle = 9000 - lookup(_atanTable, ((uint32_t)ax << 15) / ay);
+    }
+    if (x < 0) angle = 18000 - angle;
+    return y < 0 ? -angle : angle;
+}
+
+int ArmKinematics::sin(int angle) {
+    angle %= 36000;
+    if (angle < 0) angle += 36000;
+    
+    int sign = 1;
+    if (angle >= 18000) {
+        angle -= 18000;
+        sign = -1;
+    }
+    if (angle > 9000) angle = 18000 - angle;
+    // 9000 hundredths of a degree is 256 table entries, in Q7
+    return sign * lookup(_sinTable, ((uint32_t)angle << 15) / 9000);
+}
+
+int ArmKinematics::cos(int angle) {
+    return sin(angle + 9000);
+}
+
+uint32_t ArmKinematics::sqrt(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+bool ArmKinematics::clampWorkspace(int& x, int& y) {
+    uint32_t length = sqrt((uint32_t)(x * x + y * y));
+    if (length > MAX_REACH) {
+        x = x * MAX_REACH / (int)length;
+        y = y * MAX_REACH / (int)length;
+        return true;
+    }
+    if (length < MIN_REACH) {
+        if (length == 0) {
+            x = MIN_REACH;
+            return true;
+        }
+        x = x * MIN_REACH / (int)length;
+        y = y * MIN_REACH / (int)length;
+        return true;
+    }
+    return false;
+}
+
+void ArmKinematics::solve(int x, int y, int wristOffset, ArmAngles& angles) {
+    const int32_t bicepSquared = BICEP_LENGTH * BICEP_LENGTH;
+    const int32_t forearmSquared = FOREARM_LENGTH * FOREARM_LENGTH;
+    int32_t lengthSquared = x * x + y * y;
+    // Length to the wrist in Q8, a whole mm is too coarse close to the shoulder
+    int64_t length = (int64_t)sqrt64((uint64_t)lengthSquared << 16);
+    if (length == 0) length = 1;
+    
+    // Inside angle at the elbow, law of cosines
+    angles.elbow = acosRatio(bicepSquared + forearmSquared - lengthSquared,
+            2 * BICEP_LENGTH * FOREARM_LENGTH);
+    // Angle between the bicep and the line from shoulder to wrist
+    int lift = acosRatio((int64_t)(lengthSquared + bicepSquared - forearmSquared) * 256,
+            2 * length * BICEP_LENGTH);
+    int direction = atan2(y, x);
+    
+    angles.shoulder = direction + lift;
+    angles.wrist = (18000 - lift - angles.elbow) + (9000 - direction) + wristOffset;
+}
+
+void ArmKinematics::forward(const ArmAngles& angles, int& x, int& y) {
+    int forearm = angles.shoulder + angles.elbow - 18000;
+    x = (BICEP_LENGTH * cos(angles.shoulder) + FOREARM_LENGTH * cos(forearm)) >> 15;
+    y = (BICEP_LENGTH * sin(angles.shoulder) + FOREARM_LENGTH * sin(forearm)) >> 15;
+}
+
+int ArmKinematics::levelWrist(const ArmAngles& angles) {
+    int x, y;
+    forward(angles, x, y);
+    ArmAngles level;
+    solve(x, y, 0, level);
+    return level.wrist;
+}
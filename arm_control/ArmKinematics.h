@@ -0,0 +1,82 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_ARMKINEMATICS_H
+#define SORO_ARMKINEMATICS_H
+
+#include <stdint.h>
+
+/* Joint angles of the two-link arm, in hundredths of a degree.
+ * The shoulder is measured up from horizontal, the elbow is the inside
+ * angle between bicep and forearm, and the wrist is relative to the forearm.
+ */
+struct ArmAngles {
+    int shoulder;
+    int elbow;
+    int wrist;
+};
+
+/** Fixed point kinematics for the shoulder/elbow plane of the arm
+ *
+ * Trig is done with small lookup tables and square roots with an integer
+ * square root, since the Cortex-M3 has no FPU and the libm float functions
+ * are far too slow to run in the control ticker. Angles are in hundredths
+ * of a degree and lengths are in mm.
+ */
+namespace ArmKinematics {
+
+    /** Four quadrant arctangent, accurate to about 0.01 degrees
+     *
+     * @param y, x Any scale up to +/-65535
+     * @returns Angle of (x, y) from the x axis, -18000 to 18000
+     */
+    int atan2(int y, int x);
+
+    /** Sine of an angle, in Q15 (32767 = 1.0) */
+    int sin(int angle);
+
+    /** Cosine of an angle, in Q15 (32767 = 1.0) */
+    int cos(int angle);
+
+    /** Integer square root, rounded down */
+    uint32_t sqrt(uint32_t value);
+
+    /** Pull a target back inside the reach of the arm
+     *
+     * @returns true if the target had to be moved
+     */
+    bool clampWorkspace(int& x, int& y);
+
+    /** Work out the joint angles that put the wrist at (x, y)
+     *
+     * @param x Distance out from the shoulder, in mm
+     * @param y Height above the shoulder, in mm
+     * @param wristOffset Wrist angle added on top of keeping the bucket level
+     * @param angles Receives the joint angles
+     */
+    void solve(int x, int y, int wristOffset, ArmAngles& angles);
+
+    /** Work out where the wrist is from the shoulder and elbow angles */
+    void forward(const ArmAngles& angles, int& x, int& y);
+
+    /** The wrist angle that keeps the bucket level at a pose, so
+     * forward() followed by solve() can recover the wrist offset
+     */
+    int levelWrist(const ArmAngles& angles);
+}
+
+#endif
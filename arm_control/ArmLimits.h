@@ -0,0 +1,135 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_ARMLIMITS_H
+#define SORO_ARMLIMITS_H
+
+/* Geometry and calibrated servo limits of the arm. These are shared by the
+ * firmware and the host tools that generate tables for it.
+ */
+
+//DO NOT CHANGE THESE THE PROGRAM WILL NOT WORK CORRECTLY
+#define PI 3.1415926
+#define FOREARM_LENGTH 300
+#define BICEP_LENGTH 275
+/*#define FOREARM_LENGTH 339
+#define BICEP_LENGTH 266
+#define BUCKET_HEIGHT 146
+#define BUCKET_DEPTH 76
+#define BUCKET_OFFSET 19
+#define SHOULDER_OFFSET 66*/
+
+/*                          BUCKET_OFFSET
+                            o   | 
+            SPRING_HEIGHT - |\  |
+                            | o--O Wrist
+                           /--|   \
+          BUCKET_HEIGHT - /   |    \
+                          \   |     \ - FOREARM_LENGTH
+                           \__|      \  
+                            |         \
+                            |          \
+                      BUCKET_DEPTH      O Elbow
+                                       /
+                                      /
+                                     /
+                                    / - BICEP_LENGTH
+                                   / 
+                                  /
+                                 O Shoulder
+                                 | - SHOULDER_OFFSET
+                                -O-
+                                Yaw
+*/
+
+// 0.46 BOTTOM FOR SHOULDER
+// 0.21 UP FOR SHOULDER
+// 0.05 BACK FOR SHOULDER
+
+// Elbow low 0.05
+// Elbow high 0.3
+
+//values from old arm
+/*#define SHOULDER_MIN 0.05
+#define SHOULDER_MAX 0.55
+#define ELBOW_MIN 0.1
+#define ELBOW_MAX 0.60
+#define WRIST_MIN 0
+#define WRIST_MAX 0.4
+#define BUCKET_MIN 0
+#define BUCKET_MAX 0.56
+#define YAW_MIN 0
+#define YAW_MAX 1*/
+
+/************************************
+ * These are the limits for the arm *
+ ************************************/
+
+#define DUMP_SHOULDER 0.3700
+#define DUMP_ELBOW 0.9070
+#define DUMP_YAW 0.1020
+
+#define HOME_SHOULDER 0.4556
+#define HOME_YAW 0.4882
+#define HOME_ELBOW 1.0000
+#define HOME_WRIST 0.6022
+#define HOME_BUCKET 0.3066
+
+#define EXTENDED_ELBOW 0.5496
+#define EXTENDED_SHOULDER 0.0000
+#define UP_WRIST 0.1420
+#define DOWN_WRIST 1.0000
+#define YAW_FULL_RIGHT 0.0000
+#define YAW_FULL_LEFT 1.0000
+
+#define BUCKET_OPEN 0.8000
+#define BUCKET_CLOSE 0.2000
+
+#define MIN_YAW YAW_FULL_RIGHT
+#define MAX_YAW YAW_FULL_LEFT
+#define MIN_BUCKET BUCKET_CLOSE
+#define MAX_BUCKET BUCKET_OPEN
+#define MIN_WRIST UP_WRIST
+#define MAX_WRIST DOWN_WRIST
+#define MIN_ELBOW EXTENDED_ELBOW
+#define MAX_ELBOW HOME_ELBOW
+#define MIN_SHOULDER EXTENDED_SHOULDER
+#define MAX_SHOULDER HOME_SHOULDER
+
+#define CRASH_ON_CAGE_SHOULDER 0.2946
+#define CRASH_ON_CAGE_YAW_MIN 0.2260
+#define CRASH_ON_CAGE_YAW_MAX 0.8068
+#define CRASH_ON_FRAME_ELBOW 0.9580
+
+/* Angle calibration for Cartesian (gamepad) control. A joint at ZERO_ANGLE
+ * degrees is at servo position ZERO_POSITION, and DEGREES_PER_RANGE degrees
+ * covers the whole servo range. Carried over from the old float IK.
+ */
+#define SHOULDER_ZERO_ANGLE 10
+#define SHOULDER_ZERO_POSITION 0.46
+#define SHOULDER_DEGREES_PER_RANGE -360
+#define ELBOW_ZERO_ANGLE 11
+#define ELBOW_ZERO_POSITION 0.1
+#define ELBOW_DEGREES_PER_RANGE 360
+#define WRIST_ZERO_ANGLE 45
+#define WRIST_ZERO_POSITION 0.0
+#define WRIST_DEGREES_PER_RANGE 180
+
+// Converts a normalized servo position to the 0-65535 scale of Servo::write_u16()
+#define SERVO_U16(position) ((unsigned short)((position) * 65535 + 0.5))
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ArmTrajectory.h"
+
+#include <cstring>
+
+ArmTrajectory::ArmTrajectory(ServoGroup& joints, const JointLimits* limits, int rate)
+        : _joints(joints), _limits(limits) {
+    _dt = 1.0f / rate;
+    _frameCount = 0;
+    _current = 0;
+    _done = NULL;
+    _arrived = false;
+    _hold = 0;
+    _running = false;
+    for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+        _position[i] = 0;
+        _velocity[i] = 0;
+        _known[i] = false;
+    }
+}
+
+void ArmTrajectory::start(const ArmKeyframe* frames, int count, void (*done)()) {
+    if (count > ARM_MAX_KEYFRAMES) count = ARM_MAX_KEYFRAMES;
+    
+    // Keep the ticker out while the sequence is swapped
+    __disable_irq();
+    memcpy(_frames, frames, count * sizeof(ArmKeyframe));
+    _frameCount = count;
+    _current = 0;
+    _done = done;
+    _arrived = false;
+    for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+        // Pick up wherever the last command left the joint. If a sequence
+        // was interrupted the joint keeps its velocity so the motion stays smooth
+        if (fabs(_joints[i].read() - _position[i]) > ARRIVE_TOLERANCE) {
+            _position[i] = _joints[i].read();
+            _velocity[i] = 0;
+        }
+    }
+    _running = count > 0;
+    __enable_irq();
+}
+
+void ArmTrajectory::stop() {
+    _running = false;
+    for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+        _velocity[i] = 0;
+    }
+}
+
+void ArmTrajectory::step() {
+    if (!_running) return;
+    
+    const ArmKeyframe& frame = _frames[_current];
+    if (!_arrived) {
+        bool arrived = true;
+        for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+            if (!(frame.joints & JOINT_BIT(i))) continue;
+            if (!_known[i]) {
+                // Never been positioned, all we can do is send it there
+                // and let its motion model say when it's done
+                _joints.stage(i, frame.target[i]);
+                _position[i] = frame.target[i];
+                _velocity[i] = 0;
+                _known[i] = true;
+                continue;
+            }
+            arrived &= stepJoint(i, frame.target[i]);
+        }
+        _joints.commit();
+        if (!arrived) return;
+        _arrived = true;
+        _hold = frame.dwell;
+    }
+    
+    // The profile is done, now wait for the horns to catch up with it
+    for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+        if ((frame.joints & JOINT_BIT(i)) && !_joints[i].settled()) return;
+    }
+    
+    _hold -= _dt;
+    if (_hold > 0) return;
+    
+    _arrived = false;
+    if (++_current >= _frameCount) {
+        _running = false;
+        if (_done) _done();
+    }
+}
+
+/* Moves a joint one tick towards its target, accelerating while there is
+ * still room to stop and decelerating once there isn't.
+ * Returns true once the joint is at its target. The new position is only
+ * staged, step() commits all of the joints together.
+ */
+bool ArmTrajectory::stepJoint(int joint, float target) {
+    const JointLimits& limits = _limits[joint];
+    float position = _position[joint];
+    float velocity = _velocity[joint];
+    float distance = target - position;
+    float dv = limits.maxAcceleration * _dt;
+    
+    if ((fabs(distance) <= ARRIVE_TOLERANCE) && (fabs(velocity) <= dv)) {
+        _position[joint] = target;
+        _velocity[joint] = 0;
+        _joints.stage(joint, target);
+        return true;
+    }
+    
+    float direction = distance > 0 ? 1.0f : -1.0f;
+    if ((velocity * direction < 0) || (velocity * velocity < 2 * limits.maxAcceleration * fabs(distance))) {
+        velocity += direction * dv;
+        if (velocity > limits.maxVelocity) velocity = limits.maxVelocity;
+        else if (velocity < -limits.maxVelocity) velocity = -limits.maxVelocity;
+    }
+    else {
+        velocity -= direction * dv;
+    }
+    
+    position += velocity * _dt;
+    if ((target - position) * direction < 0) {
+        // Would overshoot, stop on the target instead
+        position = target;
+        velocity = 0;
+    }
+    
+    _position[joint] = position;
+    _velocity[joint] = velocity;
+    _joints.stage(joint, position);
+    return false;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_ARMTRAJECTORY_H
+#define SORO_ARMTRAJECTORY_H
+
+#include "mbed.h"
+#include "ServoGroup.h"
+
+#define ARM_JOINT_COUNT 5
+#define ARM_MAX_KEYFRAMES 8
+
+// Mask bit for a joint in ArmKeyframe::joints
+#define JOINT_BIT(joint) (1 << (joint))
+
+// A joint is considered there once it is this close to its target
+#define ARRIVE_TOLERANCE 0.002f
+
+enum ArmJoint {
+    ArmJoint_Yaw = 0,
+    ArmJoint_Shoulder,
+    ArmJoint_Elbow,
+    ArmJoint_Wrist,
+    ArmJoint_Bucket
+};
+
+/* How fast a joint may be driven, in normalized servo range per second
+ */
+struct JointLimits {
+    float maxVelocity;
+    float maxAcceleration;
+};
+
+/* One step of a movement sequence. Only the joints in the mask move,
+ * and the next keyframe starts once their servos have all come to rest
+ * and the dwell time has passed.
+ */
+struct ArmKeyframe {
+    unsigned char joints;
+    float target[ARM_JOINT_COUNT];
+    float dwell;
+};
+
+/** Runs multi-joint keyframe sequences in the background
+ *
+ * step() is called at a fixed rate from a Ticker and moves each joint
+ * along a trapezoidal velocity profile, so the main loop is free to keep
+ * servicing the network while the arm stows, deploys or dumps. All joints
+ * are committed together once per step.
+ *
+ * The servos usually lag the profile, so each keyframe also waits for the
+ * servo motion models (Servo::motion()) to say the joints have come to
+ * rest. A joint that has never been positioned is sent straight to its
+ * target, and its model works out how long that could take.
+ */
+class ArmTrajectory {
+
+public:
+    /** Create a trajectory executor
+     *
+     * @param joints Group with one servo per ArmJoint, in ArmJoint order
+     * @param limits Velocity and acceleration limits for each ArmJoint
+     * @param rate Rate step() will be called at, in Hz
+     */
+    ArmTrajectory(ServoGroup& joints, const JointLimits* limits, int rate);
+
+    /** Start a keyframe sequence, replacing any sequence in progress
+     *
+     * @param frames Keyframes to run in order, they are copied
+     * @param count Number of keyframes, at most ARM_MAX_KEYFRAMES
+     * @param done Called from step() once the last keyframe is finished
+     */
+    void start(const ArmKeyframe* frames, int count, void (*done)() = NULL);
+
+    /** Abandon the current sequence and leave the joints where they are */
+    void stop();
+
+    /** Advance the sequence by one tick, only call this from the control Ticker */
+    void step();
+
+    inline bool running() {
+        return _running;
+    }
+
+protected:
+    bool stepJoint(int joint, float target);
+
+    ServoGroup& _joints;
+    const JointLimits* _limits;
+    float _dt;
+
+    ArmKeyframe _frames[ARM_MAX_KEYFRAMES];
+    int _frameCount;
+    int _current;
+    void (*_done)();
+
+    float _position[ARM_JOINT_COUNT];
+    float _velocity[ARM_JOINT_COUNT];
+    bool _known[ARM_JOINT_COUNT];
+    bool _arrived;
+    float _hold;
+    volatile bool _running;
+};
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "CollisionMap.h"
+
+/* Position along an axis in cells, 16.16 fixed point
+ */
+static inline int32_t coordinate(const CollisionAxis& axis, unsigned short position) {
+    if (position <= axis.min) return 0;
+    if (position > axis.max) position = axis.max;
+    return (int32_t)((uint32_t)(position - axis.min) * axis.scale);
+}
+
+static inline int cell(const CollisionAxis& axis, unsigned short position) {
+    return coordinate(axis, position) >> 16;
+}
+
+static inline bool blocked(const int* cells) {
+    return (_collisionMap[cells[0]][cells[1]] >> cells[2]) & 1;
+}
+
+bool CollisionMap::poseClear(const CollisionPose& pose) {
+    int cells[3] = {
+        cell(_collisionYawAxis, pose.yaw),
+        cell(_collisionShoulderAxis, pose.shoulder),
+        cell(_collisionElbowAxis, pose.elbow)
+    };
+    return !blocked(cells);
+}
+
+bool CollisionMap::pathClear(const CollisionPose& from, const CollisionPose& to) {
+    int32_t start[3] = {
+        coordinate(_collisionYawAxis, from.yaw),
+        coordinate(_collisionShoulderAxis, from.shoulder),
+        coordinate(_collisionElbowAxis, from.elbow)
+    };
+    int32_t end[3] = {
+        coordinate(_collisionYawAxis, to.yaw),
+        coordinate(_collisionShoulderAxis, to.shoulder),
+        coordinate(_collisionElbowAxis, to.elbow)
+    };
+    
+    // Walk the segment one cell boundary at a time (a 3D DDA). For each axis
+    // the next boundary is crossed at t = next / length along the segment,
+    // and the axis whose boundary comes first is stepped. When two boundaries
+    // are crossed at once they are stepped one after the other, which also
+    // checks a corner neighbour the segment only touches.
+    int cells[3], last[3], direction[3];
+    int32_t length[3], next[3];
+    for (int i = 0; i < 3; i++) {
+        cells[i] = start[i] >> 16;
+        last[i] = end[i] >> 16;
+        if (end[i] >= start[i]) {
+            direction[i] = 1;
+            length[i] = end[i] - start[i];
+            next[i] = ((cells[i] + 1) << 16) - start[i];
+        }
+        else {
+            direction[i] = -1;
+            length[i] = start[i] - end[i];
+            next[i] = start[i] - (cells[i] << 16);
+        }
+    }
+    
+    while (true) {
+        int axis = -1;
+        for (int i = 0; i < 3; i++) {
+            if (cells[i] == last[i]) continue;
+            // next[i] / length[i] < next[axis] / length[axis], without dividing
+            if ((axis == -1) || ((int64_t)next[i] * length[axis] < (int64_t)next[axis] * length[i])) {
+                axis = i;
+            }
+        }
+        if (axis == -1) return true;
+        
+        cells[axis] += direction[axis];
+        next[axis] += 1 << 16;
+        if (blocked(cells)) return false;
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_COLLISIONMAP_H
+#define SORO_COLLISIONMAP_H
+
+#include <stdint.h>
+
+// Grid resolution over each joint's calibrated range. Changing these means
+// regenerating CollisionMapTable.cpp with tools/collision_map.
+#define COLLISION_YAW_CELLS 64
+#define COLLISION_SHOULDER_CELLS 32
+#define COLLISION_ELBOW_CELLS 32
+
+/* Maps a joint position onto a grid cell:
+ * cell = ((position - min) * scale) >> 16, with position clamped to min-max
+ */
+struct CollisionAxis {
+    unsigned short min;
+    unsigned short max;
+    uint32_t scale;
+};
+
+/* A pose of the joints that can hit the cage, on the Servo::write_u16() scale
+ */
+struct CollisionPose {
+    unsigned short yaw;
+    unsigned short shoulder;
+    unsigned short elbow;
+};
+
+// Generated tables, see CollisionMapTable.cpp
+extern const CollisionAxis _collisionYawAxis;
+extern const CollisionAxis _collisionShoulderAxis;
+extern const CollisionAxis _collisionElbowAxis;
+
+// One bit per elbow cell, set where the arm would hit the cage or frame
+extern const uint32_t _collisionMap[COLLISION_YAW_CELLS][COLLISION_SHOULDER_CELLS];
+
+/* Lookups into an occupancy grid over (yaw, shoulder, elbow), built offline
+ * and kept in flash. A cell is only marked if the whole cell is in collision,
+ * so poses clamped right up to the cage limits are never rejected.
+ */
+namespace CollisionMap {
+
+    /** Check a single pose in constant time
+     *
+     * @returns true if the pose is clear of the cage and frame
+     */
+    bool poseClear(const CollisionPose& pose);
+
+    /** Check every grid cell the straight joint-space line between two poses
+     * passes through, including cells it only touches at an edge or corner
+     *
+     * The starting cell isn't checked, so an arm that is already somewhere it
+     * shouldn't be can always move. At most 125 cells are looked up.
+     *
+     * @returns true if the arm can move from one pose to the other without
+     * passing through the cage or frame
+     */
+    bool pathClear(const CollisionPose& from, const CollisionPose& to);
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MasterFollower.h"
+
+#include <climits>
+
+// Weight given to each new interval in the smoothed packet period, as a shift
+#define PERIOD_SMOOTHING 2
+
+MasterFollower::MasterFollower(int rate, int period, int leadTime, int horizon, int leadLimit, int timeout) {
+    int periodTicks = period * rate / 1000;
+    if (periodTicks < 2) periodTicks = 2;
+    // Senders that only send on change can go much faster than the nominal rate
+    _minPeriod = 2 << 4;
+    _maxPeriod = (periodTicks * 2) << 4;
+    _period = periodTicks << 4;
+    _leadTicks = leadTime * rate / 1000;
+    _horizonTicks = horizon * rate / 1000;
+    _leadLimit = leadLimit;
+    _timeoutTicks = timeout * rate / 1000;
+    _tick = 0;
+    _arrival = 0;
+    _settling = false;
+    _fresh = false;
+    _receivedAt = 0;
+    _stepped = false;
+    _steppedReceivedAt = 0;
+    _steppedAt = 0;
+    _active = false;
+    for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+        _from[i] = 0;
+        _pose[i] = 0;
+        _velocity[i] = 0;
+        _setpoint[i] = 0;
+    }
+}
+
+void MasterFollower::receive(const unsigned short* pose, const unsigned short* current, uint32_t receivedAt) {
+    // Keep the ticker out while the pose is swapped
+    __disable_irq();
+    bool moving = _active && !_settling;
+    if (!_active) {
+        for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+            _setpoint[i] = current[i];
+        }
+    }
+    else if (moving) {
+        // Bursts and gaps in delivery are smoothed out of the period, so two
+        // packets arriving together don't look like the master jumped
+        int interval = (int)(_tick - _arrival) << 4;
+        if (interval < _minPeriod) interval = _minPeriod;
+        else if (interval > _maxPeriod) interval = _maxPeriod;
+        _period += (interval - _period) >> PERIOD_SMOOTHING;
+    }
+    retarget(pose, moving ? _period : 0);
+    _receivedAt = receivedAt;
+    _fresh = true;
+    _active = true;
+    __enable_irq();
+}
+
+void MasterFollower::stop() {
+    _active = false;
+    _fresh = false;
+}
+
+bool MasterFollower::stepped(uint32_t& receivedAt, uint32_t& steppedAt) {
+    if (!_stepped) return false;
+    __disable_irq();
+    receivedAt = _steppedReceivedAt;
+    steppedAt = _steppedAt;
+    _stepped = false;
+    __enable_irq();
+    return true;
+}
+
+/* Starts blending from the current setpoint towards a new pose. The velocity
+ * is the change from the last pose over velocityTicks (Q4), or zero if that is 0.
+ */
+void MasterFollower::retarget(const unsigned short* pose, int velocityTicks) {
+    for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+        _from[i] = _setpoint[i];
+        _velocity[i] = velocityTicks ? (pose[i] - _pose[i]) * (256 << 4) / velocityTicks : 0;
+        _pose[i] = pose[i];
+    }
+    _arrival = _tick;
+    _settling = false;
+}
+
+bool MasterFollower::step(unsigned short* setpoint) {
+    if (!_active) return false;
+    
+    _tick++;
+    int elapsed = _tick - _arrival;
+    if (!_settling && (elapsed > _timeoutTicks)) {
+        // The master has gone quiet, come back from any prediction
+        // onto the last pose it actually sent
+        for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+            _from[i] = _setpoint[i];
+            _velocity[i] = 0;
+        }
+        _arrival = _tick;
+        _settling = true;
+        elapsed = 0;
+    }
+    
+    int ahead = elapsed + _leadTicks;
+    if (ahead > _horizonTicks) ahead = _horizonTicks;
+    int blend = _period >> 4;
+    for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+        int lead = _velocity[i] * ahead / 256;
+        if (lead > _leadLimit) lead = _leadLimit;
+        else if (lead < -_leadLimit) lead = -_leadLimit;
+        int target = _pose[i] + lead;
+        
+        int position = target;
+        if (elapsed < blend) {
+            position = _from[i] + (target - _from[i]) * elapsed / blend;
+        }
+        if (position < 0) position = 0;
+        else if (position > USHRT_MAX) position = USHRT_MAX;
+        _setpoint[i] = position;
+        setpoint[i] = (unsigned short)position;
+    }
+    
+    if (_fresh) {
+        _fresh = false;
+        _steppedReceivedAt = _receivedAt;
+        _steppedAt = us_ticker_read();
+        _stepped = true;
+    }
+    
+    if (_settling && (elapsed >= blend)) {
+        _active = false;
+    }
+    return true;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_MASTERFOLLOWER_H
+#define SORO_MASTERFOLLOWER_H
+
+#include "mbed.h"
+#include "ArmTrajectory.h"
+
+/** Turns master arm poses arriving every few tens of ms into a setpoint
+ * for every control tick
+ *
+ * Each new pose starts a blend from the current setpoint to where the
+ * master is predicted to be, taking one packet interval. The prediction is
+ * the newest pose carried forward along the velocity between the last two,
+ * leadTime ahead to make up for the network delay. It is never carried more
+ * than leadLimit past the pose or further than horizon after it arrived, so
+ * a lost packet or a wrong guess can only overshoot a little. If no pose
+ * arrives for timeout the setpoint settles on the last one and the follower
+ * stops.
+ *
+ * receive(), stop() and stepped() are called from the main loop, step()
+ * from the control Ticker.
+ */
+class MasterFollower {
+
+public:
+    /** Create a stopped follower
+     *
+     * @param rate Rate step() will be called at, in Hz
+     * @param period Expected time between poses, in ms, poses may come up to
+     * twice as far apart or much closer
+     * @param leadTime How far ahead of the newest pose to predict, in ms
+     * @param horizon Longest time after a pose to keep predicting from it, in ms
+     * @param leadLimit Furthest any joint may be predicted past the pose, in write_u16() counts
+     * @param timeout Time without a pose before settling and stopping, in ms
+     */
+    MasterFollower(int rate, int period, int leadTime, int horizon, int leadLimit, int timeout);
+
+    /** Hand over a new master pose
+     *
+     * @param pose Target for each ArmJoint, in ArmJoint order
+     * @param current Where each joint is now, only used if the follower was stopped
+     * @param receivedAt When the pose arrived in us, handed back by stepped()
+     */
+    void receive(const unsigned short* pose, const unsigned short* current, uint32_t receivedAt);
+
+    /** Stop producing setpoints and forget the pose history */
+    void stop();
+
+    /** Advance by one tick, only call this from the control Ticker
+     *
+     * @param setpoint Set to the position for each ArmJoint this tick
+     * @returns false if the follower is stopped and setpoint was not set
+     */
+    bool step(unsigned short* setpoint);
+
+    /** Find out when the newest pose first produced a setpoint
+     *
+     * @param receivedAt Set to the time given to receive() with the pose
+     * @param steppedAt Set to us_ticker_read() when step() first moved towards it
+     * @returns false if no new pose has been stepped since the last call
+     */
+    bool stepped(uint32_t& receivedAt, uint32_t& steppedAt);
+
+    inline bool active() {
+        return _active;
+    }
+
+protected:
+    void retarget(const unsigned short* pose, int velocityTicks);
+
+    int _leadTicks;
+    int _horizonTicks;
+    int _leadLimit;
+    int _timeoutTicks;
+    int _minPeriod;
+    int _maxPeriod;
+
+    unsigned int _tick;
+    unsigned int _arrival;      // _tick when the newest pose arrived
+    int _period;                // smoothed ticks between poses, Q4
+    bool _settling;
+    bool _fresh;                // the newest pose hasn't been stepped yet
+    uint32_t _receivedAt;       // of the newest pose
+
+    // Set by step() for stepped(), which clears _stepped again
+    volatile bool _stepped;
+    uint32_t _steppedReceivedAt;
+    uint32_t _steppedAt;
+
+    int _from[ARM_JOINT_COUNT];
+    int _pose[ARM_JOINT_COUNT];
+    int _velocity[ARM_JOINT_COUNT];     // counts per tick, Q8
+    int _setpoint[ARM_JOINT_COUNT];
+    volatile bool _active;
+};
+
+#endif
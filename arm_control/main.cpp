@@ -16,6 +16,16 @@
 
 #include "mbed.h"
 #include "Servo.h"
+#include "ServoGroup.h"
+#include "ArmTrajectory.h"
+#include "ArmLimits.h"
+#include "CollisionMap.h"
+#include "ArmKinematics.h"
+#include "MasterFollower.h"
+#include "LatencyTrace.h"
+#include "DiagnosticMessage.h"
+#include "MessageDrain.h"
+#include "JitterBuffer.h"
 #include "armmessage.h"
 #include "mbedchannel.h"
 #include "enums.h"
@@ -24,288 +34,418 @@
 
 #include <climits>
 
-//DO NOT CHANGE THESE THE PROGRAM WILL NOT WORK CORRECTLY
-#define PI 3.1415926
-#define FOREARM_LENGTH 300
-#define BICEP_LENGTH 275
-/*#define FOREARM_LENGTH 339
-#define BICEP_LENGTH 266
-#define BUCKET_HEIGHT 146
-#define BUCKET_DEPTH 76
-#define BUCKET_OFFSET 19
-#define SHOULDER_OFFSET 66*/
-
-/*                          BUCKET_OFFSET
-                            o   | 
-            SPRING_HEIGHT - |\  |
-                            | o--O Wrist
-                           /--|   \
-          BUCKET_HEIGHT - /   |    \
-                          \   |     \ - FOREARM_LENGTH
-                           \__|      \  
-                            |         \
-                            |          \
-                      BUCKET_DEPTH      O Elbow
-                                       /
-                                      /
-                                     /
-                                    / - BICEP_LENGTH
-                                   / 
-                                  /
-                                 O Shoulder
-                                 | - SHOULDER_OFFSET
-                                -O-
-                                Yaw
-*/
-
-// 0.46 BOTTOM FOR SHOULDER
-// 0.21 UP FOR SHOULDER
-// 0.05 BACK FOR SHOULDER
-
-// Elbow low 0.05
-// Elbow high 0.3
-
-//values from old arm
-/*#define SHOULDER_MIN 0.05
-#define SHOULDER_MAX 0.55
-#define ELBOW_MIN 0.1
-#define ELBOW_MAX 0.60
-#define WRIST_MIN 0
-#define WRIST_MAX 0.4
-#define BUCKET_MIN 0
-#define BUCKET_MAX 0.56
-#define YAW_MIN 0
-#define YAW_MAX 1*/
-
-/************************************
- * These are the limits for the arm *
- ************************************/
-
-#define DUMP_SHOULDER 0.3700
-#define DUMP_ELBOW 0.9070
-#define DUMP_YAW 0.1020
-
-#define HOME_SHOULDER 0.4556
-#define HOME_YAW 0.4882
-#define HOME_ELBOW 1.0000
-#define HOME_WRIST 0.6022
-#define HOME_BUCKET 0.3066
-
-#define EXTENDED_ELBOW 0.5496
-#define EXTENDED_SHOULDER 0.0000
-#define UP_WRIST 0.1420
-#define DOWN_WRIST 1.0000
-#define YAW_FULL_RIGHT 0.0000
-#define YAW_FULL_LEFT 1.0000
-
-#define BUCKET_OPEN 0.8000
-#define BUCKET_CLOSE 0.2000
-
-#define MIN_YAW YAW_FULL_RIGHT
-#define MAX_YAW YAW_FULL_LEFT
-#define MIN_BUCKET BUCKET_CLOSE
-#define MAX_BUCKET BUCKET_OPEN
-#define MIN_WRIST UP_WRIST
-#define MAX_WRIST DOWN_WRIST
-#define MIN_ELBOW EXTENDED_ELBOW
-#define MAX_ELBOW HOME_ELBOW
-#define MIN_SHOULDER EXTENDED_SHOULDER
-#define MAX_SHOULDER HOME_SHOULDER
-
-#define CRASH_ON_CAGE_SHOULDER 0.2946
-#define CRASH_ON_CAGE_YAW_MIN 0.2260
-#define CRASH_ON_CAGE_YAW_MAX 0.8068
-#define CRASH_ON_FRAME_ELBOW 0.9580
+/* Limits, poses and cage bounds for one joint, all on the write_u16() scale.
+ * For the yaw the cage bounds are the window where the arm is over the cage,
+ * for the other joints they are the range allowed while it is.
+ */
+struct JointDescriptor {
+    unsigned short min;
+    unsigned short max;
+    unsigned short span;    // max - min, scales a 0-65535 master value into the limits
+    unsigned short home;
+    unsigned short dump;
+    unsigned short cageMin;
+    unsigned short cageMax;
+};
+
+#define JOINT_DESCRIPTOR(min, max, home, dump, cageMin, cageMax) \
+    { SERVO_U16(min), SERVO_U16(max), SERVO_U16(max) - SERVO_U16(min), \
+      SERVO_U16(home), SERVO_U16(dump), SERVO_U16(cageMin), SERVO_U16(cageMax) }
+
+/* Everything the control path needs to know about each joint, in ArmJoint
+ * order. The compiler works all of this out from the limits above, so
+ * nothing per packet needs floating point.
+ */
+const JointDescriptor _jointTable[ARM_JOINT_COUNT] = {
+    JOINT_DESCRIPTOR(MIN_YAW, MAX_YAW, HOME_YAW, DUMP_YAW,
+            CRASH_ON_CAGE_YAW_MIN, CRASH_ON_CAGE_YAW_MAX),
+    JOINT_DESCRIPTOR(MIN_SHOULDER, MAX_SHOULDER, HOME_SHOULDER, DUMP_SHOULDER,
+            EXTENDED_SHOULDER, CRASH_ON_CAGE_SHOULDER),
+    JOINT_DESCRIPTOR(MIN_ELBOW, MAX_ELBOW, HOME_ELBOW, DUMP_ELBOW,
+            EXTENDED_ELBOW, CRASH_ON_FRAME_ELBOW),
+    JOINT_DESCRIPTOR(MIN_WRIST, MAX_WRIST, HOME_WRIST, HOME_WRIST,
+            MIN_WRIST, MAX_WRIST),
+    JOINT_DESCRIPTOR(MIN_BUCKET, MAX_BUCKET, HOME_BUCKET, HOME_BUCKET,
+            MIN_BUCKET, MAX_BUCKET)
+};
+
+/*****************************************
+ * These are the limits for arm movement *
+ *****************************************/
+
+// Rate of the control ticker running movement sequences and following
+// the master arm, in Hz
+#define ARM_CONTROL_RATE 500
+
+// Kept below what the servos can do under load, so the arm actually
+// follows the profile and each keyframe ends with the arm in place
+#define YAW_MAX_VELOCITY 0.20
+#define YAW_MAX_ACCELERATION 0.40
+#define SHOULDER_MAX_VELOCITY 0.35
+#define SHOULDER_MAX_ACCELERATION 0.70
+#define ELBOW_MAX_VELOCITY 0.35
+#define ELBOW_MAX_ACCELERATION 0.70
+#define WRIST_MAX_VELOCITY 0.50
+#define WRIST_MAX_ACCELERATION 1.00
+#define BUCKET_MAX_VELOCITY 0.50
+#define BUCKET_MAX_ACCELERATION 1.00
+
+// Cartesian jogging with the gamepad, rates are at full stick
+#define JOG_SPEED 160           // mm/s
+#define JOG_YAW_SPEED 0.16      // yaw range per second
+#define JOG_WRIST_SPEED 900     // hundredths of a degree per second
+#define JOG_WRIST_LIMIT 5700    // furthest the wrist can tilt off level
+#define JOG_MIN_X 30
+#define JOG_MIN_Y -200
+#define JOG_TIMEOUT_MS 250      // stop jogging if the gamepad goes quiet
+
+// Following the master arm between packets. The prediction hides about the
+// one-way network delay, and is bounded so a wrong guess is only a small
+// overshoot. The lead limit is a fraction of the servo range.
+#define MASTER_PERIOD_MS 50     // nominal time between master arm packets
+#define MASTER_LEAD_MS 40       // how far ahead of the newest pose to predict
+#define MASTER_HORIZON_MS 100   // stop predicting this long after a pose
+#define MASTER_LEAD_LIMIT 0.03
+#define MASTER_TIMEOUT_MS 250   // settle on the last pose if the master goes quiet
+
+// Longest traced commands are held to even out bursty delivery, in us.
+// 0 applies every command as soon as it arrives.
+#define COMMAND_JITTER_DEPTH 40000
+
+// How the joint servos move, so sequences wait exactly as long as they need
+// to. Rated speeds are with no load in servo range per second, the load
+// factor is the fraction of that each joint manages on the arm, and the
+// settle time is how long the horn takes to come to rest, in seconds.
+#define YAW_RATED_SPEED 0.50
+#define YAW_LOAD_FACTOR 0.6
+#define YAW_SETTLE_TIME 0.10
+#define SHOULDER_RATED_SPEED 0.70
+#define SHOULDER_LOAD_FACTOR 0.6
+#define SHOULDER_SETTLE_TIME 0.10
+#define ELBOW_RATED_SPEED 0.70
+#define ELBOW_LOAD_FACTOR 0.6
+#define ELBOW_SETTLE_TIME 0.10
+#define WRIST_RATED_SPEED 1.00
+#define WRIST_LOAD_FACTOR 0.8
+#define WRIST_SETTLE_TIME 0.05
+#define BUCKET_RATED_SPEED 1.00
+#define BUCKET_LOAD_FACTOR 0.8
+#define BUCKET_SETTLE_TIME 0.05
+
+// Extra time to hold the stow position once the servos have come to rest,
+// before cutting power to the arm
+#define STOW_POWER_OFF_DELAY 0.2
 
 using namespace Soro;
 
-Servo *_yawServo = NULL;
-Servo *_shoulderServo = NULL;
-Servo *_elbowServo = NULL;
-Servo *_wristServo = NULL;
-Servo *_bucketServo = NULL;
+// Servos are not centered on startup, they stay where they are
+// until the stow sequence positions them in a safe order
+Servo _yawServo(p23, false);
+Servo _shoulderServo(p22, false);
+Servo _elbowServo(p21, false);
+Servo _wristServo(p24, false);
+Servo _bucketServo(p25, false);
 
 // default to arm OFF
 Servo _powerToggle(p26);
 
-float _yawRangeRatio;
-float _shoulderRangeRatio;
-float _elbowRangeRatio;
-float _wristRangeRatio;
-float _bucketRangeRatio;
+// The five joint servos in ArmJoint order, written together once per update
+ServoGroup _joints;
 
-int _x;
-int _y;
-float _t;
+const JointLimits _jointLimits[ARM_JOINT_COUNT] = {
+    { YAW_MAX_VELOCITY, YAW_MAX_ACCELERATION },
+    { SHOULDER_MAX_VELOCITY, SHOULDER_MAX_ACCELERATION },
+    { ELBOW_MAX_VELOCITY, ELBOW_MAX_ACCELERATION },
+    { WRIST_MAX_VELOCITY, WRIST_MAX_ACCELERATION },
+    { BUCKET_MAX_VELOCITY, BUCKET_MAX_ACCELERATION }
+};
 
-bool _stowed = false;
+/* Stow sequence. The shoulder and elbow come up first so the yaw doesn't
+ * crash into the cage, then the yaw comes home, then everything else.
+ */
+const ArmKeyframe _stowFrames[] = {
+    { JOINT_BIT(ArmJoint_Shoulder) | JOINT_BIT(ArmJoint_Elbow),
+        { 0, CRASH_ON_CAGE_SHOULDER, EXTENDED_ELBOW, 0, 0 }, 0 },
+    { JOINT_BIT(ArmJoint_Yaw),
+        { HOME_YAW, 0, 0, 0, 0 }, 0 },
+    { JOINT_BIT(ArmJoint_Shoulder) | JOINT_BIT(ArmJoint_Elbow) | JOINT_BIT(ArmJoint_Wrist) | JOINT_BIT(ArmJoint_Bucket),
+        { 0, HOME_SHOULDER, HOME_ELBOW, HOME_WRIST, HOME_BUCKET }, STOW_POWER_OFF_DELAY }
+};
+
+/* Startup sequence, the stow sequence followed by bringing the
+ * shoulder up to cage height
+ */
+const ArmKeyframe _startupFrames[] = {
+    { JOINT_BIT(ArmJoint_Shoulder) | JOINT_BIT(ArmJoint_Elbow),
+        { 0, CRASH_ON_CAGE_SHOULDER, EXTENDED_ELBOW, 0, 0 }, 0 },
+    { JOINT_BIT(ArmJoint_Yaw),
+        { HOME_YAW, 0, 0, 0, 0 }, 0 },
+    { JOINT_BIT(ArmJoint_Shoulder) | JOINT_BIT(ArmJoint_Elbow) | JOINT_BIT(ArmJoint_Wrist) | JOINT_BIT(ArmJoint_Bucket),
+        { 0, HOME_SHOULDER, HOME_ELBOW, HOME_WRIST, HOME_BUCKET }, 0 },
+    { JOINT_BIT(ArmJoint_Shoulder),
+        { 0, CRASH_ON_CAGE_SHOULDER, 0, 0, 0 }, 0 }
+};
+
+/* Deploy sequence, brings the shoulder up to cage height ready for control
+ */
+const ArmKeyframe _deployFrames[] = {
+    { JOINT_BIT(ArmJoint_Yaw) | JOINT_BIT(ArmJoint_Shoulder) | JOINT_BIT(ArmJoint_Elbow) | JOINT_BIT(ArmJoint_Wrist),
+        { HOME_YAW, CRASH_ON_CAGE_SHOULDER, HOME_ELBOW, HOME_WRIST, 0 }, 0 }
+};
+
+ArmTrajectory _trajectory(_joints, _jointLimits, ARM_CONTROL_RATE);
+Ticker _controlTicker;
+
+// Jog state for gamepad control. Everything is in Q8 so slow rates still
+// move, and the rates are per control tick.
+volatile bool _jogging = false;
+volatile int _jogRateX, _jogRateY, _jogRateYaw, _jogRateWrist;
+volatile unsigned short _jogBucket;
+int _jogX, _jogY, _jogYaw, _jogWrist;
+Timer _jogTimer;
+
+// Setpoints for every control tick between master arm packets
+MasterFollower _follower(ARM_CONTROL_RATE, MASTER_PERIOD_MS, MASTER_LEAD_MS,
+        MASTER_HORIZON_MS, SERVO_U16(MASTER_LEAD_LIMIT), MASTER_TIMEOUT_MS);
+unsigned short _masterBucket;
+
+// Time from a master arm packet arriving to the first setpoint from its pose
+// going out to the servos
+LatencyTrace _latency;
+
+// Plays traced commands out at the rate they were sent
+JitterBuffer _jitter(COMMAND_JITTER_DEPTH);
 
-bool floatBetween(float value, float range1, float range2) {
-    if (range1 > range2) {
-        return (value > range2) & (value < range1);
-    }
-    else {
-        return (value > range1) & (value < range2);
-    }
-}
+bool _stowed = false;
+bool _dumping = false;
 
-void clampFloat(float& value, float min, float max) {
+inline void clampJoint(unsigned short& value, unsigned short min, unsigned short max) {
     if (value < min) value = min;
     else if (value > max) value = max;
 }
 
+/* Maps a 0-65535 master arm reading onto a joint's limits
+ */
+inline unsigned short masterToServo(int joint, unsigned short master) {
+    const JointDescriptor& descriptor = _jointTable[joint];
+    // Stretch 0-65535 to 0-65536 so a full scale reading lands exactly on max
+    unsigned int q16 = master + (master >> 15);
+    return descriptor.min + (unsigned short)((q16 * descriptor.span) >> 16);
+}
+
 /* ONLY use this function to alter the position of any servo, except
  * possibly in a predefined movement sequence where you are very careful
  */
-void setPositions(float yaw, float shoulder, float elbow, float wrist, float bucket) {
-    clampFloat(yaw, MIN_YAW, MAX_YAW);
-    clampFloat(shoulder, MIN_SHOULDER, MAX_SHOULDER);
-    clampFloat(elbow, MIN_ELBOW, MAX_ELBOW);
-    clampFloat(wrist, MIN_WRIST, MAX_WRIST);
-    clampFloat(bucket, MIN_BUCKET, MAX_BUCKET);
+void setPositions(unsigned short yaw, unsigned short shoulder, unsigned short elbow,
+        unsigned short wrist, unsigned short bucket) {
+    clampJoint(yaw, _jointTable[ArmJoint_Yaw].min, _jointTable[ArmJoint_Yaw].max);
+    clampJoint(shoulder, _jointTable[ArmJoint_Shoulder].min, _jointTable[ArmJoint_Shoulder].max);
+    clampJoint(elbow, _jointTable[ArmJoint_Elbow].min, _jointTable[ArmJoint_Elbow].max);
+    clampJoint(wrist, _jointTable[ArmJoint_Wrist].min, _jointTable[ArmJoint_Wrist].max);
+    clampJoint(bucket, _jointTable[ArmJoint_Bucket].min, _jointTable[ArmJoint_Bucket].max);
     
     // check for arm crashing on cage
-    if (floatBetween(yaw, CRASH_ON_CAGE_YAW_MIN, CRASH_ON_CAGE_YAW_MAX)) {
-        clampFloat(shoulder, EXTENDED_SHOULDER, CRASH_ON_CAGE_SHOULDER);
-        clampFloat(elbow, EXTENDED_ELBOW, CRASH_ON_FRAME_ELBOW);
+    if ((yaw > _jointTable[ArmJoint_Yaw].cageMin) && (yaw < _jointTable[ArmJoint_Yaw].cageMax)) {
+        clampJoint(shoulder, _jointTable[ArmJoint_Shoulder].cageMin, _jointTable[ArmJoint_Shoulder].cageMax);
+        clampJoint(elbow, _jointTable[ArmJoint_Elbow].cageMin, _jointTable[ArmJoint_Elbow].cageMax);
     }
     
-    *_yawServo = yaw;
-    *_shoulderServo = shoulder;
-    *_elbowServo = elbow;
-    *_wristServo = wrist;
-    *_bucketServo = bucket;
+    // check for arm sweeping through the cage on the way there
+    CollisionPose from = { _yawServo.read_u16(), _shoulderServo.read_u16(), _elbowServo.read_u16() };
+    CollisionPose to = { yaw, shoulder, elbow };
+    if (!CollisionMap::pathClear(from, to)) {
+        // try getting the shoulder and elbow out of the way first, then
+        // moving the yaw first, otherwise stay put until the next command
+        CollisionPose armFirst = { from.yaw, shoulder, elbow };
+        CollisionPose yawFirst = { yaw, from.shoulder, from.elbow };
+        if (CollisionMap::pathClear(from, armFirst)) {
+            yaw = from.yaw;
+        }
+        else if (CollisionMap::pathClear(from, yawFirst)) {
+            shoulder = from.shoulder;
+            elbow = from.elbow;
+        }
+        else {
+            yaw = from.yaw;
+            shoulder = from.shoulder;
+            elbow = from.elbow;
+        }
+    }
+    
+    _joints.stage_u16(ArmJoint_Yaw, yaw);
+    _joints.stage_u16(ArmJoint_Shoulder, shoulder);
+    _joints.stage_u16(ArmJoint_Elbow, elbow);
+    _joints.stage_u16(ArmJoint_Wrist, wrist);
+    _joints.stage_u16(ArmJoint_Bucket, bucket);
+    _joints.commit();
 }
 
-/*void setElbowAngle(int angle){
-    angle -= 11;
-    float res = (0.1) + (((float) angle) / 360.0f);
-    setElbow(res);
+/* Converts a joint angle in hundredths of a degree to a servo position
+ */
+unsigned short angleToServo(int angle, int zeroAngle, float zeroPosition, int degreesPerRange) {
+    int offset = angle - zeroAngle * 100;
+    if (offset > 32767) offset = 32767;
+    else if (offset < -32767) offset = -32767;
+    int position = SERVO_U16(zeroPosition) + offset * 65535 / (degreesPerRange * 100);
+    if (position < 0) return 0;
+    if (position > USHRT_MAX) return USHRT_MAX;
+    return (unsigned short)position;
 }
 
-void setShoulderAngle(int angle){
-    angle -= 10;
-    float res = (0.46) - (((float) angle) / 360.0f);
-    setShoulder(res);
+int servoToAngle(unsigned short position, int zeroAngle, float zeroPosition, int degreesPerRange) {
+    return zeroAngle * 100 + (position - SERVO_U16(zeroPosition)) * (degreesPerRange * 100) / 65535;
 }
 
-void setWristAngle(int angle){
-    angle -= 45;
-    float res = ((float) angle) / 180;
-    setWrist(res);
+/* Picks up jogging from wherever the arm is now
+ */
+void startJog() {
+    ArmAngles angles;
+    angles.shoulder = servoToAngle(_shoulderServo.read_u16(),
+            SHOULDER_ZERO_ANGLE, SHOULDER_ZERO_POSITION, SHOULDER_DEGREES_PER_RANGE);
+    angles.elbow = servoToAngle(_elbowServo.read_u16(),
+            ELBOW_ZERO_ANGLE, ELBOW_ZERO_POSITION, ELBOW_DEGREES_PER_RANGE);
+    int wrist = servoToAngle(_wristServo.read_u16(),
+            WRIST_ZERO_ANGLE, WRIST_ZERO_POSITION, WRIST_DEGREES_PER_RANGE);
+    int x, y;
+    ArmKinematics::forward(angles, x, y);
+    _jogX = x * 256;
+    _jogY = y * 256;
+    _jogYaw = _yawServo.read_u16() * 256;
+    _jogWrist = (wrist - ArmKinematics::levelWrist(angles)) * 256;
+    _jogBucket = _bucketServo.read_u16();
+    _jogRateX = _jogRateY = _jogRateYaw = _jogRateWrist = 0;
+    _jogTimer.start();
+    _jogTimer.reset();
+    _jogging = true;
 }
 
-inline float toDegrees(float theta){
-    return ((theta * 180.0f) / PI);
+/* Moves the wrist target along at the gamepad rates and solves for the
+ * joints. Runs from the control ticker.
+ */
+void jogStep() {
+    if (!_jogging) return;
+    if (_jogTimer.read_ms() > JOG_TIMEOUT_MS) {
+        _jogging = false;
+        return;
+    }
+    
+    _jogX += _jogRateX;
+    _jogY += _jogRateY;
+    _jogYaw += _jogRateYaw;
+    _jogWrist += _jogRateWrist;
+    
+    int x = _jogX / 256;
+    int y = _jogY / 256;
+    if (ArmKinematics::clampWorkspace(x, y)) {
+        _jogX = x * 256;
+        _jogY = y * 256;
+    }
+    if (x < JOG_MIN_X) {
+        x = JOG_MIN_X;
+        _jogX = x * 256;
+    }
+    if (y < JOG_MIN_Y) {
+        y = JOG_MIN_Y;
+        _jogY = y * 256;
+    }
+    if (_jogYaw < 0) _jogYaw = 0;
+    else if (_jogYaw > USHRT_MAX * 256) _jogYaw = USHRT_MAX * 256;
+    if (_jogWrist < -JOG_WRIST_LIMIT * 256) _jogWrist = -JOG_WRIST_LIMIT * 256;
+    else if (_jogWrist > JOG_WRIST_LIMIT * 256) _jogWrist = JOG_WRIST_LIMIT * 256;
+    
+    ArmAngles angles;
+    ArmKinematics::solve(x, y, _jogWrist / 256, angles);
+    setPositions(_jogYaw / 256,
+            angleToServo(angles.shoulder, SHOULDER_ZERO_ANGLE, SHOULDER_ZERO_POSITION, SHOULDER_DEGREES_PER_RANGE),
+            angleToServo(angles.elbow, ELBOW_ZERO_ANGLE, ELBOW_ZERO_POSITION, ELBOW_DEGREES_PER_RANGE),
+            angleToServo(angles.wrist, WRIST_ZERO_ANGLE, WRIST_ZERO_POSITION, WRIST_DEGREES_PER_RANGE),
+            _jogBucket);
 }
 
-inline float signum(float x){
-    return x < 0 ? -1 : 1;
+/* Starts moving the arm into the stow position. This returns right away,
+ * the sequence runs from the control ticker. Joints that have never been
+ * positioned (on startup) are moved at once, and their motion models say
+ * how long to wait for them.
+ */
+void stow(void (*done)() = NULL) {
+    _follower.stop();
+    _trajectory.start(_stowFrames, sizeof(_stowFrames) / sizeof(ArmKeyframe), done);
 }
 
-void calcAngles(int x, int y, float t){
-    float lengthOne = BICEP_LENGTH;
-    float lengthTwo = FOREARM_LENGTH;
-
-    float lengthSq = (x*x) + (y*y);
-    float length = sqrt(lengthSq);
-
-    float phiOne = signum(y) * acos(x / length);
-    float phiTwo = acos( ((length * length) + (lengthOne * lengthOne) - (lengthTwo * lengthTwo)) / (2 * length * lengthOne) );
-
-    float thetaOne = phiOne + phiTwo;
-
-    float thetaTwo = acos( ((lengthOne * lengthOne) + (lengthTwo * lengthTwo) - (lengthSq)) / (2 * lengthOne * lengthTwo) );
-
-
-
-    float wristAngle = (PI - phiTwo - thetaTwo) + ((PI / 2) - phiOne) + t;
-    //pc.printf("Wrist angle: %d\r\n", (int) toDegrees(wristAngle));
-    //pc.printf("Setting shoulder to: %d\r\n", (int) toDegrees(thetaOne) );
-    //pc.printf("Setting elbow to: %d\r\n", (int) toDegrees(thetaTwo) );
-    setShoulderAngle((int) toDegrees(thetaOne));
-    setElbowAngle((int) toDegrees(thetaTwo));
-    setWristAngle((int) toDegrees(wristAngle));
+/* Starts moving the arm out of the stow position
+ */
+void deploy() {
+    _follower.stop();
+    _trajectory.start(_deployFrames, sizeof(_deployFrames) / sizeof(ArmKeyframe));
 }
 
-float length(int x, int y){
-    return sqrt(((float) (x * x)) + ((float) (y * y)));
+/* Starts moving the arm into the dump position, keeping the
+ * wrist and bucket where the master arm wants them
+ */
+void dump(unsigned short wrist, unsigned short bucket) {
+    ArmKeyframe frame = {
+        JOINT_BIT(ArmJoint_Yaw) | JOINT_BIT(ArmJoint_Shoulder) | JOINT_BIT(ArmJoint_Elbow) | JOINT_BIT(ArmJoint_Wrist) | JOINT_BIT(ArmJoint_Bucket),
+        { DUMP_YAW, DUMP_SHOULDER, DUMP_ELBOW, wrist * (1.0f / 65535), bucket * (1.0f / 65535) }, 0
+    };
+    _follower.stop();
+    _trajectory.start(&frame, 1);
 }
 
-int newY(int newx, int newy){
-    int ret = newy;
-    if(length(newx, newy) > BICEP_LENGTH + FOREARM_LENGTH){
-        //pc.printf("too big %d > %d\r\n", (int) length(newx, newy), (int) BICEP_LENGTH + FOREARM_LENGTH);
-        float ang = atan2((float)newy,(float)newx);
-        ret = (BICEP_LENGTH + FOREARM_LENGTH - 10) * sin(ang);
-    }
-
-    if(ret < -200){
-        ret = -200;
-    }
+/* Called from the control ticker once the stow sequence is finished
+ */
+void powerOff() {
+    _powerToggle = 0.0;
+}
 
-    return ret;
+/* Moves the arm towards wherever the master arm is expected to be by now
+ * and passes every setpoint through the limit and cage checks. Runs from
+ * the control ticker.
+ *
+ * @returns false if the master arm isn't in control
+ */
+bool followStep() {
+    unsigned short setpoint[ARM_JOINT_COUNT];
+    if (!_follower.step(setpoint)) return false;
+    setPositions(setpoint[ArmJoint_Yaw], setpoint[ArmJoint_Shoulder], setpoint[ArmJoint_Elbow],
+            setpoint[ArmJoint_Wrist], setpoint[ArmJoint_Bucket]);
+    return true;
 }
 
-int newX(int newx, int newy){
-    int ret = newx;
-    if(length(newx, newy) >= BICEP_LENGTH + FOREARM_LENGTH){
-        //pc.printf("too big %d > %d\r\n", (int) length(newx, newy), (int) BICEP_LENGTH + FOREARM_LENGTH);
-        float ang = atan2((float)newy,(float)newx);
-        ret = (BICEP_LENGTH + FOREARM_LENGTH - 10) * cos(ang);
+void controlTick() {
+    // Keeps every joint's motion model from going wrong when the clock
+    // wraps, however long the arm sits still
+    for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+        _joints[i].update();
     }
-
-    if(ret < 30){
-        ret = 30;
+    _trajectory.step();
+    if (!_trajectory.running()) {
+        if (!followStep()) {
+            jogStep();
+        }
     }
+}
 
-    return ret;
-}*/
-
-/* Sets the arm in the stow position.
- * If 'safe' it will wait until the yaw is positioned before
- * moving any other servos. Otherwise, all servos will be moved at once.
+/* Handles the stow switch, which works the same in either control mode.
+ * Returns true if the rest of the command should be ignored because the
+ * arm is stowed or on its way in or out of stow.
  */
-void stow(bool knownPosition) {
-    float wait1, wait2;
-    if (knownPosition && _yawServo && _shoulderServo) {
-        wait1 = abs(*_shoulderServo - CRASH_ON_CAGE_SHOULDER) * 3 + 1;
-        wait2 = abs(*_yawServo - HOME_YAW) * 6 + 1;
-    }
-    else {
-        wait1 = 2;
-        wait2 = 2;
-    }
-    //make sure yaw doesn't crash into cage because shoulder is too low
-    if (!_shoulderServo) {
-        _shoulderServo = new Servo(p22);
-    }
-    if (!_elbowServo) {
-        _elbowServo = new Servo(p21);
-    }
-    *_shoulderServo = CRASH_ON_CAGE_SHOULDER;
-    *_elbowServo = EXTENDED_ELBOW;
-    wait(wait1);
-    //position yaw and wait to make sure it gets there
-    if (!_yawServo) {
-        _yawServo = new Servo(p23);
-    }
-    *_yawServo = HOME_YAW;
-    wait(wait2);
-    //set shoulder home
-    *_shoulderServo = HOME_SHOULDER;
-    //set elbow home
-    *_elbowServo = HOME_ELBOW;
-    if (!_wristServo) {
-        _wristServo = new Servo(p24);
+bool handleStow(bool stowRequested) {
+    if (stowRequested) {
+        if (!_stowed) {
+            _jogging = false;
+            stow(&powerOff);
+            _stowed = true;
+            _dumping = false;
+        }
+        return true;
     }
-    if (!_bucketServo) {
-        _bucketServo = new Servo(p25);
+    if (_stowed) {
+        _powerToggle = 1.0;
+        _stowed = false;
+        deploy();
+        return true;
     }
-    //set wrist
-    *_wristServo = HOME_WRIST;
-    //set bucket
-    *_bucketServo = HOME_BUCKET;
+    return false;
 }
 
 /* Listener which receives the ethernet's disconnected
@@ -314,102 +454,138 @@ void stow(bool knownPosition) {
  * when the mbed turns back on.
  */
 void preResetListener() {
-    stow(true);
+    stow();
+    while (_trajectory.running()) {
+        wait_ms(10);
+    }
 }
 
 int main() {
-   
-    //used to calculate positions in master/slave control
-    _yawRangeRatio = (MAX_YAW - MIN_YAW) / (float)USHRT_MAX;
-    _shoulderRangeRatio = (MAX_SHOULDER - MIN_SHOULDER) / (float)USHRT_MAX;
-    _elbowRangeRatio = (MAX_ELBOW - MIN_ELBOW) / (float)USHRT_MAX;
-    _wristRangeRatio = (MAX_WRIST - MIN_WRIST) / (float)USHRT_MAX;
-    _bucketRangeRatio = (MAX_BUCKET - MIN_BUCKET) / (float)USHRT_MAX;
-    
     MbedChannel ethernet(MBED_ID_ARM, NETWORK_ROVER_ARM_MBED_PORT);   
     ethernet.setResetListener(&preResetListener);
-    ethernet.setTimeout(500);
     char buffer[50];
     
-    _powerToggle = 1.0;
-    stow(false);
-    *_shoulderServo = CRASH_ON_CAGE_SHOULDER;
-    wait(1);
+    _joints.add(_yawServo);
+    _joints.add(_shoulderServo);
+    _joints.add(_elbowServo);
+    _joints.add(_wristServo);
+    _joints.add(_bucketServo);
+    _yawServo.motion(YAW_RATED_SPEED, YAW_LOAD_FACTOR, YAW_SETTLE_TIME);
+    _shoulderServo.motion(SHOULDER_RATED_SPEED, SHOULDER_LOAD_FACTOR, SHOULDER_SETTLE_TIME);
+    _elbowServo.motion(ELBOW_RATED_SPEED, ELBOW_LOAD_FACTOR, ELBOW_SETTLE_TIME);
+    _wristServo.motion(WRIST_RATED_SPEED, WRIST_LOAD_FACTOR, WRIST_SETTLE_TIME);
+    _bucketServo.motion(BUCKET_RATED_SPEED, BUCKET_LOAD_FACTOR, BUCKET_SETTLE_TIME);
+    _controlTicker.attach_us(&controlTick, 1000000 / ARM_CONTROL_RATE);
     
     //Stow the arm. This will end very bad if the arm is not
     //alrady close to stow position, but we have no choice.
+    _powerToggle = 1.0;
+    _trajectory.start(_startupFrames, sizeof(_startupFrames) / sizeof(ArmKeyframe));
     
+    // After a stall (like waiting for stow) only the newest command is applied
+    MessageDrain messages(ethernet, _latency, 500);
+    messages.setJitterBuffer(&_jitter);
+    uint32_t receivedAt;
     while(1) {
-        int len = ethernet.read(&buffer[0], 50);
+        int len = messages.read(&buffer[0], &receivedAt);
+        
+        // Master arm poses are actuated by the control ticker, which leaves
+        // the times here for the main loop to collect
+        uint32_t poseReceivedAt, poseSteppedAt;
+        if (_follower.stepped(poseReceivedAt, poseSteppedAt)) {
+            _latency.actuated(poseReceivedAt, poseSteppedAt);
+        }
         if (len != -1) {
             unsigned int header = (unsigned int)reinterpret_cast<unsigned char&>(buffer[0]);
-            MbedMessageType messageType = reinterpret_cast<MbedMessageType&>(header);
-            switch (messageType) {
-             /*case MbedMessage_ArmGamepad: ///////////////////////////////////////////
-                //TODO - this is very rough. Needs cleaning up and more adding wrist, bucket functionality.
-                _x -= (int)(ArmMessage::getGamepadX(buffer) * 8);
-                _y -= (int)(ArmMessage::getGamepadY(buffer) * 8);
-                setYaw(_yawServo - ((float)ArmMessage::getGamepadYaw(buffer) * 0.008));
-                if (ArmMessage::getBucketOpen(buffer)) {
-                    setBucket(BUCKET_OPEN);
+            switch (header) {
+            case MbedMessage_ArmGamepad: /////////////////////////////////////////
+                if (_trajectory.running()) {
+                    // let the current sequence finish before taking new commands
+                    break;
                 }
-                else if (ArmMessage::getBucketClose(buffer)) {
-                    setBucket(BUCKET_CLOSED);
+                if (handleStow(ArmMessage::getStow(buffer))) {
+                    break;
                 }
-                if ((_t < 1) & (_t > -1)) {
-                    _t = _t - ((float)ArmMessage::getGamepadWrist(buffer) * 0.008);    
+                if (!_jogging) {
+                    _follower.stop();
+                    startJog();
                 }
-                if (ArmMessage::getStow(buffer)) {
-                    stow(true);
+                _jogTimer.reset();
+                _jogRateX = (int)(-ArmMessage::getGamepadX(buffer) * (JOG_SPEED * 256 / ARM_CONTROL_RATE));
+                _jogRateY = (int)(-ArmMessage::getGamepadY(buffer) * (JOG_SPEED * 256 / ARM_CONTROL_RATE));
+                _jogRateYaw = (int)(-ArmMessage::getGamepadYaw(buffer) * (JOG_YAW_SPEED * 65535 * 256 / ARM_CONTROL_RATE));
+                _jogRateWrist = (int)(-ArmMessage::getGamepadWrist(buffer) * (JOG_WRIST_SPEED * 256 / ARM_CONTROL_RATE));
+                if (ArmMessage::getBucketOpen(buffer)) {
+                    _jogBucket = _jointTable[ArmJoint_Bucket].max;
                 }
-                else {
-                    _x = newX(_x,_y);
-                    _y = newY(_x,_y);
-                    calcAngles(_x, _y, _t);
+                else if (ArmMessage::getBucketClose(buffer)) {
+                    _jogBucket = _jointTable[ArmJoint_Bucket].min;
                 }
-                break;*/
+                break;
             case MbedMessage_ArmMaster: //////////////////////////////////////////
-                if (ArmMessage::getStow(buffer)) {
-                    if (!_stowed) {
-                        stow(true);
-                        _stowed = true;
-                        wait(3);
-                        _powerToggle = 0.0;
-                    }
-                }
-                else if (_stowed) {
-                    _powerToggle = 1.0;
-                    _stowed = false;
-                    *_shoulderServo = CRASH_ON_CAGE_SHOULDER;
-                    *_yawServo = HOME_YAW;
-                    *_elbowServo = HOME_ELBOW;
-                    *_wristServo = HOME_WRIST;
-                    wait(1);
+                _jogging = false;
+                if (_trajectory.running()) {
+                    // let the current sequence finish before taking new commands
+                    break;
                 }
-                else {
-                    float bucket = *_bucketServo;
+                if (!handleStow(ArmMessage::getStow(buffer))) {
+                    // While following, the servo is still on its way to the
+                    // last target, so keep that instead of where it is now
+                    unsigned short bucket = _follower.active() ? _masterBucket : _bucketServo.read_u16();
                     if (ArmMessage::getBucketOpen(buffer)) {
-                        bucket = BUCKET_OPEN;
+                        bucket = _jointTable[ArmJoint_Bucket].max;
                     }
                     else if (ArmMessage::getBucketClose(buffer)) {
-                        bucket = BUCKET_CLOSE;
+                        bucket = _jointTable[ArmJoint_Bucket].min;
                     }
+                    _masterBucket = bucket;
+                    unsigned short wrist = masterToServo(ArmJoint_Wrist, ArmMessage::getMasterWrist(buffer));
                     if (ArmMessage::getDump(buffer)) {
-                        setPositions(DUMP_YAW,
-                                DUMP_SHOULDER,
-                                DUMP_ELBOW,
-                                ArmMessage::getMasterWrist(buffer) * _wristRangeRatio + MIN_WRIST,
+                        if (!_dumping) {
+                            _dumping = true;
+                            dump(wrist, bucket);
+                            break;
+                        }
+                        setPositions(_jointTable[ArmJoint_Yaw].dump,
+                                _jointTable[ArmJoint_Shoulder].dump,
+                                _jointTable[ArmJoint_Elbow].dump,
+                                wrist,
                                 bucket);
+                        _latency.actuated(receivedAt);
                     }
                     else {
-                        setPositions(ArmMessage::getMasterYaw(buffer) * _yawRangeRatio + MIN_YAW,
-                                ArmMessage::getMasterShoulder(buffer) * _shoulderRangeRatio + MIN_SHOULDER,
-                                ArmMessage::getMasterElbow(buffer) * _elbowRangeRatio + MIN_ELBOW,
-                                ArmMessage::getMasterWrist(buffer) * _wristRangeRatio + MIN_WRIST,
-                                bucket);
+                        _dumping = false;
+                        unsigned short pose[ARM_JOINT_COUNT] = {
+                            masterToServo(ArmJoint_Yaw, ArmMessage::getMasterYaw(buffer)),
+                            masterToServo(ArmJoint_Shoulder, ArmMessage::getMasterShoulder(buffer)),
+                            masterToServo(ArmJoint_Elbow, ArmMessage::getMasterElbow(buffer)),
+                            wrist,
+                            bucket
+                        };
+                        unsigned short current[ARM_JOINT_COUNT];
+                        for (int i = 0; i < ARM_JOINT_COUNT; i++) {
+                            current[i] = _joints[i].read_u16();
+                        }
+                        // The latency is sampled once the ticker steps towards it
+                        _follower.receive(pose, current, receivedAt);
                     } 
                 }
                 break;
+            case MBED_MESSAGE_ECHO: //////////////////////////////////////////////
+                ethernet.sendMessage(&buffer[0], len);
+                break;
+            case MBED_MESSAGE_LATENCY_REQUEST: { /////////////////////////////////
+                char report[DiagnosticMessage::RequiredSize_LatencyReport];
+                ethernet.sendMessage(&report[0], DiagnosticMessage::setLatencyReport(&report[0], _latency));
+                _latency.reset();
+                break;
+            }
+            case MBED_MESSAGE_JITTER_REQUEST: { //////////////////////////////////
+                char report[DiagnosticMessage::RequiredSize_JitterReport];
+                ethernet.sendMessage(&report[0], DiagnosticMessage::setJitterReport(&report[0], _jitter));
+                _jitter.reset();
+                break;
+            }
             }
         }
     }
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "GimbalMotion.h"
+
+#define PITCH 0
+#define YAW 1
+
+// A servo's whole range in 1/256ths of a count
+#define FULL_RANGE (65535 << 8)
+
+/* Converts a time to cross the whole range into a speed per tick
+ */
+static int speedFor(unsigned int time) {
+    unsigned int ticks = time * 1000 / GIMBAL_MOTION_TICK;
+    return (ticks > 0) ? FULL_RANGE / ticks : FULL_RANGE;
+}
+
+/* Converts 0 to 1 of the range into a position
+ */
+static int positionOf(float fraction) {
+    if (fraction <= 0.0f) return 0;
+    if (fraction >= 1.0f) return FULL_RANGE;
+    return (int)(fraction * 65535.0f) << 8;
+}
+
+/* Converts -1 to 1 of a speed into a speed
+ */
+static int rateOf(float fraction, int speed) {
+    if (fraction <= -1.0f) return -speed;
+    if (fraction >= 1.0f) return speed;
+    return (int)(fraction * speed);
+}
+
+GimbalMotion::GimbalMotion(Servo& pitch, Servo& yaw, unsigned int sweepTime, unsigned int presetTime,
+        unsigned int accelTime, unsigned int rateTimeout) {
+    _group.add(pitch);
+    _group.add(yaw);
+    for (int i = 0; i < 2; i++) {
+        _axes[i].position = _group[i].read_u16() << 8;
+        _axes[i].velocity = 0;
+        _axes[i].target = _axes[i].position;
+        _axes[i].rate = 0;
+    }
+    _preset = true;
+    _rateTime = 0;
+    _rateTimeout = rateTimeout;
+    _sweepSpeed = speedFor(sweepTime);
+    _presetSpeed = speedFor(presetTime);
+    
+    unsigned int accelTicks = accelTime * 1000 / GIMBAL_MOTION_TICK;
+    if (accelTicks == 0) accelTicks = 1;
+    _accel = _presetSpeed / accelTicks;
+    if (_accel == 0) _accel = 1;
+    // Slowing in proportion to the distance left never brakes harder than _accel
+    _brakeTicks = accelTicks;
+}
+
+void GimbalMotion::start() {
+    _clock.start();
+    _ticker.attach_us(this, &GimbalMotion::tick, GIMBAL_MOTION_TICK);
+}
+
+void GimbalMotion::setRates(float pitch, float yaw) {
+    int pitchRate = rateOf(pitch, _sweepSpeed);
+    int yawRate = rateOf(yaw, _sweepSpeed);
+    __disable_irq();
+    _axes[PITCH].rate = pitchRate;
+    _axes[YAW].rate = yawRate;
+    _preset = false;
+    _rateTime = _clock.read_ms();
+    __enable_irq();
+}
+
+void GimbalMotion::lookAt(float pitch, float yaw) {
+    int pitchTarget = positionOf(pitch);
+    int yawTarget = positionOf(yaw);
+    __disable_irq();
+    _axes[PITCH].target = pitchTarget;
+    _axes[YAW].target = yawTarget;
+    _preset = true;
+    __enable_irq();
+}
+
+void GimbalMotion::tick() {
+    // A stick which has gone quiet means stop, not keep turning
+    if (!_preset && ((unsigned int)_clock.read_ms() - _rateTime > _rateTimeout)) {
+        _axes[PITCH].rate = 0;
+        _axes[YAW].rate = 0;
+    }
+    move(_axes[PITCH], PITCH);
+    move(_axes[YAW], YAW);
+    _group.commit();
+}
+
+void GimbalMotion::move(Axis& axis, int index) {
+    int desired = axis.rate;
+    if (_preset) {
+        int distance = axis.target - axis.position;
+        if ((distance > -_brakeTicks) && (distance < _brakeTicks) && (axis.velocity == 0)) {
+            // Close enough that the proportional approach would never finish
+            if (distance != 0) {
+                axis.position = axis.target;
+                _group.stage_u16(index, axis.position >> 8);
+            }
+            return;
+        }
+        desired = distance / _brakeTicks;
+        if (desired > _presetSpeed) desired = _presetSpeed;
+        else if (desired < -_presetSpeed) desired = -_presetSpeed;
+    }
+    
+    if (desired > axis.velocity + _accel) axis.velocity += _accel;
+    else if (desired < axis.velocity - _accel) axis.velocity -= _accel;
+    else axis.velocity = desired;
+    if (axis.velocity == 0) return;
+    
+    int position = axis.position + axis.velocity;
+    if (position <= 0) {
+        position = 0;
+        axis.velocity = 0;
+    }
+    else if (position >= FULL_RANGE) {
+        position = FULL_RANGE;
+        axis.velocity = 0;
+    }
+    int before = axis.position >> 8;
+    axis.position = position;
+    if ((position >> 8) != before) {
+        _group.stage_u16(index, position >> 8);
+    }
+}
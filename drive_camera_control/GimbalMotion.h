@@ -0,0 +1,102 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_GIMBALMOTION_H
+#define SORO_GIMBALMOTION_H
+
+#include "mbed.h"
+#include "Servo.h"
+#include "ServoGroup.h"
+
+// The gimbal moves on a ticker at this period, in us
+#define GIMBAL_MOTION_TICK 10000
+
+/** Moves a pitch and yaw gimbal at controlled speeds in the background
+ *
+ * Stick input sets a turn rate, which a ticker integrates into the servo
+ * positions, so the camera pans at the same speed however often commands
+ * arrive. If no rate arrives for a while the gimbal stops by itself. Preset
+ * looks move to their position at a limited speed and slow down as they
+ * get there, instead of jumping. Either way the speed changes at a limited
+ * acceleration, and the servos are only written when they move.
+ *
+ * Example:
+ * @code
+ * GimbalMotion gimbal(pitch, yaw, 5000, 1500, 250, 250);
+ *
+ * int main() {
+ *     gimbal.start();
+ *     gimbal.lookAt(0.5f, 0.0f);          // look left
+ *     // ...
+ *     gimbal.setRates(0.0f, 1.0f);        // pan at full speed
+ * }
+ * @endcode
+ */
+class GimbalMotion {
+
+public:
+    /** Create a gimbal which holds the positions the servos are at
+     *
+     * @param pitch Pitch servo on a PWM1 pin
+     * @param yaw Yaw servo on a PWM1 pin
+     * @param sweepTime Time to turn across the whole range at full rate, in ms
+     * @param presetTime Time for a preset look to cross the whole range at full speed, in ms
+     * @param accelTime Time to get up to the full preset speed, in ms
+     * @param rateTimeout The gimbal stops if no rate arrives for this long, in ms
+     */
+    GimbalMotion(Servo& pitch, Servo& yaw, unsigned int sweepTime, unsigned int presetTime,
+            unsigned int accelTime, unsigned int rateTimeout);
+
+    /** Start moving */
+    void start();
+
+    /** Turn at rates from -1 to 1, ending any preset look
+     *
+     * @param pitch Pitch rate, positive towards the top of the servo's range
+     * @param yaw Yaw rate, positive towards the top of the servo's range
+     */
+    void setRates(float pitch, float yaw);
+
+    /** Move to a position, 0 to 1 of each servo's range */
+    void lookAt(float pitch, float yaw);
+
+protected:
+    // Positions are in 1/256ths of a servo count, speeds in those per tick
+    struct Axis {
+        int position;
+        int velocity;
+        int target;             // position a preset look is going to
+        int rate;               // speed the stick asks for
+    };
+
+    void tick();
+    void move(Axis& axis, int index);
+
+    ServoGroup _group;          // written together, without restarting PWM1
+    Ticker _ticker;
+    Timer _clock;
+    Axis _axes[2];
+    bool _preset;
+    unsigned int _rateTime;     // when the last rate arrived, in ms
+    unsigned int _rateTimeout;
+    int _sweepSpeed;
+    int _presetSpeed;
+    int _accel;
+    int _brakeTicks;            // ticks a preset look takes to stop from full speed
+};
+
+#endif
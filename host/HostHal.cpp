@@ -0,0 +1,454 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "mbed.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+
+#define PIN_COUNT (USBRX + 1)
+
+static const char* _pinNames[PIN_COUNT] = {
+    NULL, NULL, NULL, NULL, NULL,
+    "p5", "p6", "p7", "p8", "p9", "p10", "p11", "p12", "p13", "p14", "p15",
+    "p16", "p17", "p18", "p19", "p20", "p21", "p22", "p23", "p24", "p25",
+    "p26", "p27", "p28", "p29", "p30",
+    "LED1", "LED2", "LED3", "LED4",
+    "USBTX", "USBRX"
+};
+
+static pthread_mutex_t _irqLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static volatile float _pins[PIN_COUNT];
+static InterruptIn* volatile _watchers[PIN_COUNT];
+static pthread_once_t _inputsOnce = PTHREAD_ONCE_INIT;
+static pthread_t _inputThread;
+
+static uint64_t monotonicUs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static uint64_t elapsedUs() {
+    static uint64_t start = monotonicUs();
+    return monotonicUs() - start;
+}
+
+static timespec toTimespec(uint64_t us) {
+    timespec time;
+    time.tv_sec = us / 1000000;
+    time.tv_nsec = (us % 1000000) * 1000;
+    return time;
+}
+
+static bool validPin(PinName pin) {
+    return (pin >= 0) && (pin < PIN_COUNT) && (_pinNames[pin] != NULL);
+}
+
+/***************************************
+ * Interrupts and time                 *
+ ***************************************/
+
+void __disable_irq() {
+    pthread_mutex_lock(&_irqLock);
+}
+
+void __enable_irq() {
+    pthread_mutex_unlock(&_irqLock);
+}
+
+uint32_t us_ticker_read() {
+    return (uint32_t)elapsedUs();
+}
+
+void wait_us(int us) {
+    if (us <= 0) return;
+    timespec time = toTimespec(us);
+    while ((nanosleep(&time, &time) == -1) && (errno == EINTR)) { }
+}
+
+void wait_ms(int ms) {
+    wait_us(ms * 1000);
+}
+
+void wait(float s) {
+    wait_us((int)(s * 1000000.0f));
+}
+
+/***************************************
+ * Pin table                           *
+ ***************************************/
+
+/* Parses "name=value" or "name value" and drives the pin. Returns false
+ * if the line isn't a pin setting.
+ */
+static bool parsePinSetting(const char* setting) {
+    char name[16];
+    float value;
+    if ((sscanf(setting, " %15[^= \t] = %f", name, &value) != 2)
+            && (sscanf(setting, " %15s %f", name, &value) != 2)) {
+        return false;
+    }
+    PinName pin = Host::pinByName(name);
+    if (pin == NC) return false;
+    Host::drivePin(pin, value);
+    return true;
+}
+
+/* Reads pin settings from stdin for as long as it stays open
+ */
+static void* readInputs(void*) {
+    char line[64];
+    while (fgets(line, sizeof(line), stdin)) {
+        if (!parsePinSetting(line)) {
+            fprintf(stderr, "host: ignoring input \"%s\"\n", line);
+        }
+    }
+    return NULL;
+}
+
+/* Applies MBED_HOST_PINS (e.g. "p8=1,p15=0.5") and starts the stdin reader
+ */
+static void startInputs() {
+    const char* pins = getenv("MBED_HOST_PINS");
+    if (pins) {
+        char settings[256];
+        strncpy(settings, pins, sizeof(settings) - 1);
+        settings[sizeof(settings) - 1] = '\0';
+        for (char* setting = strtok(settings, ","); setting; setting = strtok(NULL, ",")) {
+            parsePinSetting(setting);
+        }
+    }
+    if (pthread_create(&_inputThread, NULL, &readInputs, NULL) == 0) {
+        pthread_detach(_inputThread);
+    }
+}
+
+float Host::readPin(PinName pin) {
+    return validPin(pin) ? _pins[pin] : 0.0f;
+}
+
+void Host::writePin(PinName pin, float value) {
+    if (!validPin(pin)) return;
+    bool changed = _pins[pin] != value;
+    _pins[pin] = value;
+    static const bool trace = getenv("MBED_HOST_TRACE") != NULL;
+    if (trace && changed) {
+        fprintf(stderr, "%u %s %.4f\n", us_ticker_read(), _pinNames[pin], value);
+    }
+}
+
+void Host::drivePin(PinName pin, float value) {
+    if (!validPin(pin)) return;
+    __disable_irq();
+    bool wasHigh = _pins[pin] > 0.5f;
+    bool isHigh = value > 0.5f;
+    _pins[pin] = value;
+    if (_watchers[pin] && (wasHigh != isHigh)) {
+        _watchers[pin]->edge(isHigh);
+    }
+    __enable_irq();
+}
+
+void Host::watchPin(PinName pin, InterruptIn* handler) {
+    if (!validPin(pin)) return;
+    __disable_irq();
+    _watchers[pin] = handler;
+    __enable_irq();
+}
+
+const char* Host::pinName(PinName pin) {
+    return validPin(pin) ? _pinNames[pin] : "NC";
+}
+
+PinName Host::pinByName(const char* name) {
+    for (int pin = 0; pin < PIN_COUNT; pin++) {
+        if (_pinNames[pin] && (strcmp(_pinNames[pin], name) == 0)) {
+            return (PinName)pin;
+        }
+    }
+    return NC;
+}
+
+/***************************************
+ * Digital and analog IO               *
+ ***************************************/
+
+DigitalIn::DigitalIn(PinName pin, PinMode) : _pin(pin) {
+    pthread_once(&_inputsOnce, &startInputs);
+}
+
+AnalogIn::AnalogIn(PinName pin) : _pin(pin) {
+    pthread_once(&_inputsOnce, &startInputs);
+}
+
+InterruptIn::InterruptIn(PinName pin) : _pin(pin), _enabled(true) {
+    pthread_once(&_inputsOnce, &startInputs);
+    Host::watchPin(pin, this);
+}
+
+InterruptIn::~InterruptIn() {
+    Host::watchPin(_pin, NULL);
+}
+
+/***************************************
+ * Timers                              *
+ ***************************************/
+
+void Timer::start() {
+    if (_running) return;
+    _start = elapsedUs();
+    _running = true;
+}
+
+void Timer::stop() {
+    if (!_running) return;
+    _elapsed += elapsedUs() - _start;
+    _running = false;
+}
+
+void Timer::reset() {
+    _start = elapsedUs();
+    _elapsed = 0;
+}
+
+int Timer::read_us() {
+    uint64_t elapsed = _elapsed;
+    if (_running) {
+        elapsed += elapsedUs() - _start;
+    }
+    return (int)elapsed;
+}
+
+Ticker::Ticker() : _oneShot(false) {
+    init();
+}
+
+Ticker::Ticker(bool oneShot) : _oneShot(oneShot) {
+    init();
+}
+
+void Ticker::init() {
+    pthread_mutex_init(&_mutex, NULL);
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&_changed, &attributes);
+    pthread_condattr_destroy(&attributes);
+    _quit = false;
+    _started = false;
+    _generation = 0;
+    _interval = 0;
+    _next = 0;
+}
+
+Ticker::~Ticker() {
+    pthread_mutex_lock(&_mutex);
+    bool started = _started;
+    _quit = true;
+    pthread_cond_signal(&_changed);
+    pthread_mutex_unlock(&_mutex);
+    if (started && !pthread_equal(_thread, pthread_self())) {
+        pthread_join(_thread, NULL);
+    }
+}
+
+void Ticker::schedule(const FunctionPointer& handler, unsigned int us) {
+    pthread_mutex_lock(&_mutex);
+    _handler = handler;
+    _interval = us > 0 ? us : 1;
+    _next = elapsedUs() + _interval;
+    _generation++;
+    if (!_started) {
+        _started = pthread_create(&_thread, NULL, &Ticker::run, this) == 0;
+    }
+    pthread_cond_signal(&_changed);
+    pthread_mutex_unlock(&_mutex);
+}
+
+void Ticker::detach() {
+    pthread_mutex_lock(&_mutex);
+    _handler = FunctionPointer();
+    _generation++;
+    pthread_cond_signal(&_changed);
+    pthread_mutex_unlock(&_mutex);
+}
+
+void* Ticker::run(void* ticker) {
+    Ticker* self = static_cast<Ticker*>(ticker);
+    pthread_mutex_lock(&self->_mutex);
+    while (!self->_quit) {
+        if (!self->_handler) {
+            pthread_cond_wait(&self->_changed, &self->_mutex);
+            continue;
+        }
+        uint64_t now = elapsedUs();
+        if (now < self->_next) {
+            // the base time of elapsedUs() cancels out, it is only a wait
+            timespec deadline = toTimespec(monotonicUs() + (self->_next - now));
+            pthread_cond_timedwait(&self->_changed, &self->_mutex, &deadline);
+            continue;
+        }
+        FunctionPointer handler = self->_handler;
+        unsigned int generation = self->_generation;
+        if (self->_oneShot) {
+            self->_handler = FunctionPointer();
+        }
+        else {
+            self->_next += self->_interval;
+            if (now > self->_next + 100 * self->_interval) {
+                // fell far behind (stopped in a debugger), don't try to catch up
+                self->_next = now + self->_interval;
+            }
+        }
+        pthread_mutex_unlock(&self->_mutex);
+        
+        __disable_irq();
+        // skip the call if the ticker was detached or reattached meanwhile
+        pthread_mutex_lock(&self->_mutex);
+        bool current = generation == self->_generation;
+        pthread_mutex_unlock(&self->_mutex);
+        if (current) {
+            handler.call();
+        }
+        __enable_irq();
+        
+        pthread_mutex_lock(&self->_mutex);
+    }
+    pthread_mutex_unlock(&self->_mutex);
+    return NULL;
+}
+
+/***************************************
+ * Serial                              *
+ ***************************************/
+
+Serial::Serial(PinName tx, PinName, const char*) : _fd(-1), _reading(false),
+        _rxHead(0), _rxTail(0) {
+    pthread_mutex_init(&_mutex, NULL);
+    pthread_cond_init(&_received, NULL);
+    
+    char variable[32];
+    snprintf(variable, sizeof(variable), "MBED_HOST_SERIAL_%s", Host::pinName(tx));
+    const char* device = getenv(variable);
+    if (device) {
+        _fd = open(device, O_RDWR | O_NOCTTY);
+        if (_fd < 0) {
+            fprintf(stderr, "host: cannot open %s for %s\n", device, variable);
+        }
+    }
+    if (_fd < 0 && tx == USBTX) {
+        _fd = dup(STDOUT_FILENO);
+    }
+    else if (_fd >= 0) {
+        _reading = pthread_create(&_thread, NULL, &Serial::run, this) == 0;
+    }
+}
+
+Serial::~Serial() {
+    if (_reading) {
+        pthread_cancel(_thread);
+        pthread_join(_thread, NULL);
+    }
+    if (_fd >= 0) {
+        close(_fd);
+    }
+}
+
+int Serial::readable() {
+    pthread_mutex_lock(&_mutex);
+    int count = (_rxHead - _rxTail) & (sizeof(_rx) - 1);
+    pthread_mutex_unlock(&_mutex);
+    return count;
+}
+
+int Serial::getc() {
+    pthread_mutex_lock(&_mutex);
+    while (_rxHead == _rxTail) {
+        pthread_cond_wait(&_received, &_mutex);
+    }
+    int c = _rx[_rxTail];
+    _rxTail = (_rxTail + 1) & (sizeof(_rx) - 1);
+    pthread_mutex_unlock(&_mutex);
+    return c;
+}
+
+int Serial::putc(int c) {
+    unsigned char byte = (unsigned char)c;
+    if (_fd >= 0) {
+        if (write(_fd, &byte, 1) != 1) return -1;
+    }
+    return c;
+}
+
+int Serial::puts(const char* s) {
+    int length = strlen(s);
+    if (_fd >= 0) {
+        if (write(_fd, s, length) != length) return -1;
+    }
+    return length;
+}
+
+int Serial::printf(const char* format, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    puts(text);
+    return length;
+}
+
+void Serial::setHandler(const FunctionPointer& handler, IrqType type) {
+    if (type != RxIrq) return;  // writes finish immediately, so TX never interrupts
+    __disable_irq();
+    _rxHandler = handler;
+    __enable_irq();
+}
+
+/* Stands in for the UART, and calls the RX interrupt as bytes arrive
+ */
+void* Serial::run(void* serial) {
+    Serial* self = static_cast<Serial*>(serial);
+    unsigned char chunk[64];
+    while (1) {
+        int length = read(self->_fd, chunk, sizeof(chunk));
+        if (length <= 0) {
+            if ((length < 0) && (errno == EINTR)) continue;
+            return NULL;
+        }
+        for (int i = 0; i < length; i++) {
+            pthread_mutex_lock(&self->_mutex);
+            unsigned int next = (self->_rxHead + 1) & (sizeof(self->_rx) - 1);
+            if (next != self->_rxTail) {
+                // like the UART FIFO, bytes are lost when nobody reads them
+                self->_rx[self->_rxHead] = chunk[i];
+                self->_rxHead = next;
+            }
+            pthread_cond_broadcast(&self->_received);
+            pthread_mutex_unlock(&self->_mutex);
+        }
+        __disable_irq();
+        if (self->_rxHandler) {
+            self->_rxHandler.call();
+        }
+        __enable_irq();
+    }
+}
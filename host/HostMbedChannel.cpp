@@ -0,0 +1,107 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "mbedchannel.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace Soro;
+
+/* Parses "host:port" or just "port" into an address on loopback
+ */
+static bool parseAddress(const char* text, sockaddr_in& address) {
+    char host[64];
+    int port;
+    if (sscanf(text, "%63[^:]:%d", host, &port) != 2) {
+        strcpy(host, "127.0.0.1");
+        if (sscanf(text, "%d", &port) != 1) return false;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    return inet_pton(AF_INET, host, &address.sin_addr) == 1;
+}
+
+MbedChannel::MbedChannel(unsigned char mbedId, int port) : _mbedId(mbedId),
+        _timeout(1000), _resetListener(NULL) {
+    _socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (_socket < 0) {
+        perror("host: socket");
+        exit(1);
+    }
+    
+    sockaddr_in local;
+    const char* bindAddress = getenv("MBED_HOST_BIND");
+    if (!bindAddress || !parseAddress(bindAddress, local)) {
+        parseAddress("0", local);
+    }
+    if (bind(_socket, (sockaddr*)&local, sizeof(local)) < 0) {
+        perror("host: bind");
+        exit(1);
+    }
+    
+    const char* peer = getenv("MBED_HOST_PEER");
+    if (!peer || !parseAddress(peer, _peer)) {
+        char defaultPeer[16];
+        snprintf(defaultPeer, sizeof(defaultPeer), "%d", port);
+        parseAddress(defaultPeer, _peer);
+    }
+    
+    socklen_t length = sizeof(local);
+    getsockname(_socket, (sockaddr*)&local, &length);
+    fprintf(stderr, "host: mbed %d listening on %d, sending to %d\n",
+            _mbedId, ntohs(local.sin_port), ntohs(_peer.sin_port));
+}
+
+MbedChannel::~MbedChannel() {
+    close(_socket);
+}
+
+void MbedChannel::setResetListener(void (*listener)()) {
+    _resetListener = listener;
+}
+
+void MbedChannel::setTimeout(unsigned int millis) {
+    _timeout = millis;
+}
+
+void MbedChannel::sendMessage(char* message, int length) {
+    sendto(_socket, message, length, 0, (sockaddr*)&_peer, sizeof(_peer));
+}
+
+int MbedChannel::read(char* outMessage, int maxLength) {
+    pollfd waiting;
+    waiting.fd = _socket;
+    waiting.events = POLLIN;
+    int ready = poll(&waiting, 1, _timeout);
+    if (ready <= 0) {
+        return -1;
+    }
+    int length = recv(_socket, outMessage, maxLength, 0);
+    if (length == 0) {
+        if (_resetListener) {
+            _resetListener();
+        }
+        fprintf(stderr, "host: reset requested\n");
+        exit(0);
+    }
+    return length < 0 ? -1 : length;
+}
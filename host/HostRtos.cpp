@@ -0,0 +1,196 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "rtos.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+
+namespace Host {
+
+    /* Signal flags of one thread, found through _currentState by the
+     * thread itself and through Thread::_state by everyone else
+     */
+    struct ThreadState {
+        pthread_mutex_t mutex;
+        pthread_cond_t changed;
+        int32_t signals;
+    };
+}
+
+using Host::ThreadState;
+
+static pthread_key_t _currentState;
+static pthread_once_t _currentStateOnce = PTHREAD_ONCE_INIT;
+
+static void createCurrentState() {
+    pthread_key_create(&_currentState, NULL);
+}
+
+static ThreadState* newThreadState() {
+    ThreadState* state = new ThreadState;
+    pthread_mutex_init(&state->mutex, NULL);
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&state->changed, &attributes);
+    pthread_condattr_destroy(&attributes);
+    state->signals = 0;
+    return state;
+}
+
+/* State of the calling thread. The main thread gets its state the first
+ * time it asks.
+ */
+static ThreadState* currentState() {
+    pthread_once(&_currentStateOnce, &createCurrentState);
+    ThreadState* state = static_cast<ThreadState*>(pthread_getspecific(_currentState));
+    if (!state) {
+        state = newThreadState();
+        pthread_setspecific(_currentState, state);
+    }
+    return state;
+}
+
+static int32_t updateSignals(ThreadState* state, int32_t set, int32_t clear) {
+    pthread_mutex_lock(&state->mutex);
+    int32_t previous = state->signals;
+    state->signals = (previous | set) & ~clear;
+    pthread_cond_broadcast(&state->changed);
+    pthread_mutex_unlock(&state->mutex);
+    return previous;
+}
+
+osThreadId osThreadGetId() {
+    return currentState();
+}
+
+int32_t osSignalSet(osThreadId thread, int32_t signals) {
+    return updateSignals(thread, signals, 0);
+}
+
+Thread::Thread(void (*task)(void const* argument), void* argument,
+        osPriority priority, uint32_t, unsigned char*) :
+        _task(task), _argument(argument), _priority(priority) {
+    _state = newThreadState();
+    pthread_create(&_thread, NULL, &Thread::run, this);
+}
+
+Thread::~Thread() {
+    // a running pthread can't be terminated safely, so it is left running
+    pthread_detach(_thread);
+}
+
+void* Thread::run(void* thread) {
+    Thread* self = static_cast<Thread*>(thread);
+    pthread_once(&_currentStateOnce, &createCurrentState);
+    pthread_setspecific(_currentState, self->_state);
+    self->_task(self->_argument);
+    return NULL;
+}
+
+int32_t Thread::signal_set(int32_t signals) {
+    return updateSignals(_state, signals, 0);
+}
+
+int32_t Thread::signal_clr(int32_t signals) {
+    return updateSignals(_state, 0, signals);
+}
+
+osEvent Thread::signal_wait(int32_t signals, uint32_t millisec) {
+    ThreadState* state = currentState();
+    timespec deadline;
+    if (millisec != osWaitForever) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += millisec / 1000;
+        deadline.tv_nsec += (millisec % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+    
+    osEvent event;
+    pthread_mutex_lock(&state->mutex);
+    while (1) {
+        bool ready = signals ? ((state->signals & signals) == signals) : (state->signals != 0);
+        if (ready) {
+            event.status = osEventSignal;
+            event.value.signals = state->signals;
+            state->signals &= signals ? ~signals : 0;
+            break;
+        }
+        int result = (millisec == osWaitForever)
+                ? pthread_cond_wait(&state->changed, &state->mutex)
+                : pthread_cond_timedwait(&state->changed, &state->mutex, &deadline);
+        if (result == ETIMEDOUT) {
+            event.status = osEventTimeout;
+            event.value.signals = 0;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&state->mutex);
+    return event;
+}
+
+osStatus Thread::wait(uint32_t millisec) {
+    wait_ms(millisec);
+    return osEventTimeout;
+}
+
+osStatus Thread::yield() {
+    sched_yield();
+    return osOK;
+}
+
+Mutex::Mutex() {
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&_mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+}
+
+Mutex::~Mutex() {
+    pthread_mutex_destroy(&_mutex);
+}
+
+osStatus Mutex::lock(uint32_t millisec) {
+    if (millisec == osWaitForever) {
+        pthread_mutex_lock(&_mutex);
+        return osOK;
+    }
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += millisec / 1000;
+    deadline.tv_nsec += (millisec % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return pthread_mutex_timedlock(&_mutex, &deadline) == 0 ? osOK : osEventTimeout;
+}
+
+bool Mutex::trylock() {
+    return pthread_mutex_trylock(&_mutex) == 0;
+}
+
+osStatus Mutex::unlock() {
+    pthread_mutex_unlock(&_mutex);
+    return osOK;
+}
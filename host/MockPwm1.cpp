@@ -0,0 +1,61 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MockPwm1.h"
+
+#include <vector>
+
+MockPwm1Registers _mockPwm1;
+
+static std::vector<MockPwm1::Write> _writes;
+
+static void log(const MockRegister* reg, uint32_t value) {
+    MockPwm1::Write write = { reg, value };
+    _writes.push_back(write);
+}
+
+MockRegister& MockRegister::operator= (uint32_t value) {
+    _value = value;
+    log(this, _value);
+    return *this;
+}
+
+MockRegister& MockRegister::operator|= (uint32_t bits) {
+    _value |= bits;
+    log(this, _value);
+    return *this;
+}
+
+void MockPwm1::reset() {
+    _writes.clear();
+}
+
+int MockPwm1::count() {
+    return (int)_writes.size();
+}
+
+const MockPwm1::Write& MockPwm1::write(int index) {
+    return _writes[index];
+}
+
+const MockRegister* MockPwm1::match(int channel) {
+    const MockRegister* registers[] = {
+        &_mockPwm1.MR1, &_mockPwm1.MR2, &_mockPwm1.MR3,
+        &_mockPwm1.MR4, &_mockPwm1.MR5, &_mockPwm1.MR6
+    };
+    return registers[channel - 1];
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* A stand-in for the LPC1768 PWM1 match and latch enable registers, so
+ * ServoGroup's register path can be tested on the host
+ *
+ * Building ServoGroup.cpp with SERVO_GROUP_MOCK_PWM1 defined makes it
+ * write here instead of falling back to PwmOut. Every register write is
+ * logged in order, a read-modify-write like |= counting as one write.
+ */
+
+#ifndef SORO_HOST_MOCKPWM1_H
+#define SORO_HOST_MOCKPWM1_H
+
+#include <stdint.h>
+
+// PwmOut runs PWM1 from CCLK / 4, so this gives 24 ticks per us like the board
+#define SystemCoreClock 96000000
+
+class MockRegister {
+
+public:
+    MockRegister() : _value(0) { }
+
+    MockRegister& operator= (uint32_t value);
+    MockRegister& operator|= (uint32_t bits);
+
+    operator uint32_t() const {
+        return _value;
+    }
+
+private:
+    MockRegister(const MockRegister&);
+
+    uint32_t _value;
+};
+
+/* Laid out like the real block, where MR4-MR6 aren't next to MR0-MR3
+ */
+struct MockPwm1Registers {
+    MockRegister MR0, MR1, MR2, MR3;
+    MockRegister CCR, CR0, CR1, CR2, CR3;
+    MockRegister MR4, MR5, MR6;
+    MockRegister PCR, LER;
+};
+
+typedef MockRegister PwmMatchRegister;
+
+extern MockPwm1Registers _mockPwm1;
+#define LPC_PWM1 (&_mockPwm1)
+
+namespace MockPwm1 {
+
+    struct Write {
+        const MockRegister* reg;
+        uint32_t value;         // value after the write
+    };
+
+    /** Forget the logged writes, the register values are kept */
+    void reset();
+
+    /** Number of writes since the last reset() */
+    int count();
+
+    /** A logged write, 0 being the first since the last reset() */
+    const Write& write(int index);
+
+    /** Match register for a PWM1 channel, 1-6 */
+    const MockRegister* match(int channel);
+}
+
+#endif
@@ -0,0 +1,497 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/* Host (Linux) stand-in for the parts of the mbed 2 API the firmwares use.
+ *
+ * Peripherals are backed by a shared pin table instead of hardware, so
+ * inputs can be driven and outputs watched from outside the process (see
+ * README.md). Interrupt handlers run on host threads while holding a global
+ * lock, which __disable_irq() also takes, so critical sections keep the same
+ * meaning they have on the board.
+ */
+
+#ifndef SORO_HOST_MBED_H
+#define SORO_HOST_MBED_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <pthread.h>
+
+typedef enum {
+    p5 = 5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16, p17, p18, p19,
+    p20, p21, p22, p23, p24, p25, p26, p27, p28, p29, p30,
+    LED1, LED2, LED3, LED4,
+    USBTX, USBRX,
+    // LPC1768 port names for the PWM1 pins, only used to find PWM1 channels
+    P2_0 = p26, P2_1 = p25, P2_2 = p24, P2_3 = p23, P2_4 = p22, P2_5 = p21,
+    P1_18 = USBRX + 1, P1_20, P1_21, P1_23, P1_24, P1_26, P3_25, P3_26,
+    NC = -1
+} PinName;
+
+typedef enum {
+    PullUp,
+    PullDown,
+    PullNone,
+    OpenDrain,
+    PullDefault = PullDown
+} PinMode;
+
+/***************************************
+ * Interrupts and time                 *
+ ***************************************/
+
+void __disable_irq();
+void __enable_irq();
+
+inline void __DMB() {
+    __sync_synchronize();
+}
+
+/** Microseconds since the program started, wrapping like the mbed us ticker */
+uint32_t us_ticker_read();
+
+void wait(float s);
+void wait_ms(int ms);
+void wait_us(int us);
+
+/***************************************
+ * Pin table                           *
+ ***************************************/
+
+class InterruptIn;
+
+namespace Host {
+
+    /** Current value of a pin, 0-1 */
+    float readPin(PinName pin);
+
+    /** Set the value of a pin, and trace changes if MBED_HOST_TRACE is set */
+    void writePin(PinName pin, float value);
+
+    /** Set a pin from outside the firmware, firing edge interrupts */
+    void drivePin(PinName pin, float value);
+
+    /** Route edges on a pin to an InterruptIn, or stop with NULL */
+    void watchPin(PinName pin, InterruptIn* handler);
+
+    /** Name of a pin as written in the firmware, e.g. "p21" */
+    const char* pinName(PinName pin);
+
+    /** Pin with the given name, or NC */
+    PinName pinByName(const char* name);
+}
+
+/***************************************
+ * Callbacks                           *
+ ***************************************/
+
+/** A function or member function to call back, like the mbed 2 class */
+class FunctionPointer {
+
+public:
+    FunctionPointer(void (*function)() = NULL) {
+        attach(function);
+    }
+
+    template<typename T>
+    FunctionPointer(T* object, void (T::*member)()) {
+        attach(object, member);
+    }
+
+    void attach(void (*function)()) {
+        _function = function;
+        _object = NULL;
+        _thunk = NULL;
+    }
+
+    template<typename T>
+    void attach(T* object, void (T::*member)()) {
+        _function = NULL;
+        _object = object;
+        memcpy(_member, (char*)&member, sizeof(member));
+        _thunk = &FunctionPointer::memberThunk<T>;
+    }
+
+    void call() {
+        if (_function) {
+            _function();
+        }
+        else if (_thunk) {
+            _thunk(_object, _member);
+        }
+    }
+
+    operator bool() const {
+        return (_function != NULL) || (_thunk != NULL);
+    }
+
+private:
+    template<typename T>
+    static void memberThunk(void* object, char* member) {
+        void (T::*m)();
+        memcpy((char*)&m, member, sizeof(m));
+        (static_cast<T*>(object)->*m)();
+    }
+
+    void (*_function)();
+    void* _object;
+    char _member[16];
+    void (*_thunk)(void*, char*);
+};
+
+/***************************************
+ * Digital and analog IO               *
+ ***************************************/
+
+class DigitalOut {
+
+public:
+    DigitalOut(PinName pin, int value = 0) : _pin(pin) {
+        write(value);
+    }
+
+    void write(int value) {
+        Host::writePin(_pin, value ? 1.0f : 0.0f);
+    }
+
+    int read() {
+        return Host::readPin(_pin) > 0.5f;
+    }
+
+    DigitalOut& operator= (int value) {
+        write(value);
+        return *this;
+    }
+
+    operator int() {
+        return read();
+    }
+
+private:
+    PinName _pin;
+};
+
+class DigitalIn {
+
+public:
+    DigitalIn(PinName pin, PinMode mode = PullDefault);
+
+    int read() {
+        return Host::readPin(_pin) > 0.5f;
+    }
+
+    void mode(PinMode) { }
+
+    operator int() {
+        return read();
+    }
+
+private:
+    PinName _pin;
+};
+
+class AnalogIn {
+
+public:
+    AnalogIn(PinName pin);
+
+    float read() {
+        float value = Host::readPin(_pin);
+        return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    }
+
+    unsigned short read_u16() {
+        return (unsigned short)(read() * 65535.0f + 0.5f);
+    }
+
+    operator float() {
+        return read();
+    }
+
+private:
+    PinName _pin;
+};
+
+class PwmOut {
+
+public:
+    PwmOut(PinName pin) : _pin(pin), _period(20000), _pulse(0) { }
+
+    void period(float seconds) {
+        period_us((int)(seconds * 1000000.0f));
+    }
+
+    void period_ms(int ms) {
+        period_us(ms * 1000);
+    }
+
+    void period_us(int us) {
+        _period = us;
+        update();
+    }
+
+    void pulsewidth(float seconds) {
+        pulsewidth_us((int)(seconds * 1000000.0f));
+    }
+
+    void pulsewidth_ms(int ms) {
+        pulsewidth_us(ms * 1000);
+    }
+
+    void pulsewidth_us(int us) {
+        _pulse = us;
+        update();
+    }
+
+    void write(float value) {
+        value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+        pulsewidth_us((int)(value * _period));
+    }
+
+    float read() {
+        return (float)_pulse / _period;
+    }
+
+    PwmOut& operator= (float value) {
+        write(value);
+        return *this;
+    }
+
+    operator float() {
+        return read();
+    }
+
+private:
+    void update() {
+        Host::writePin(_pin, read());
+    }
+
+    PinName _pin;
+    int _period;    // us
+    int _pulse;     // us
+};
+
+class InterruptIn {
+
+public:
+    InterruptIn(PinName pin);
+    ~InterruptIn();
+
+    int read() {
+        return Host::readPin(_pin) > 0.5f;
+    }
+
+    operator int() {
+        return read();
+    }
+
+    void mode(PinMode) { }
+
+    void rise(void (*function)()) {
+        _rise.attach(function);
+    }
+
+    template<typename T>
+    void rise(T* object, void (T::*member)()) {
+        _rise.attach(object, member);
+    }
+
+    void fall(void (*function)()) {
+        _fall.attach(function);
+    }
+
+    template<typename T>
+    void fall(T* object, void (T::*member)()) {
+        _fall.attach(object, member);
+    }
+
+    void enable_irq() {
+        _enabled = true;
+    }
+
+    void disable_irq() {
+        _enabled = false;
+    }
+
+    /** Called by the pin table with the interrupt lock held */
+    void edge(bool rising) {
+        if (!_enabled) return;
+        if (rising) _rise.call();
+        else _fall.call();
+    }
+
+private:
+    PinName _pin;
+    FunctionPointer _rise;
+    FunctionPointer _fall;
+    volatile bool _enabled;
+};
+
+/***************************************
+ * Timers                              *
+ ***************************************/
+
+class Timer {
+
+public:
+    Timer() : _running(false), _start(0), _elapsed(0) { }
+
+    void start();
+    void stop();
+    void reset();
+
+    float read() {
+        return read_us() / 1000000.0f;
+    }
+
+    int read_ms() {
+        return read_us() / 1000;
+    }
+
+    int read_us();
+
+    operator float() {
+        return read();
+    }
+
+private:
+    bool _running;
+    uint64_t _start;
+    uint64_t _elapsed;
+};
+
+/** Calls a function periodically from its own host thread, with the
+ * interrupt lock held like a timer interrupt
+ */
+class Ticker {
+
+public:
+    Ticker();
+    virtual ~Ticker();
+
+    void attach(void (*function)(), float seconds) {
+        attach_us(function, (unsigned int)(seconds * 1000000.0f));
+    }
+
+    template<typename T>
+    void attach(T* object, void (T::*member)(), float seconds) {
+        attach_us(object, member, (unsigned int)(seconds * 1000000.0f));
+    }
+
+    void attach_us(void (*function)(), unsigned int us) {
+        FunctionPointer handler(function);
+        schedule(handler, us);
+    }
+
+    template<typename T>
+    void attach_us(T* object, void (T::*member)(), unsigned int us) {
+        FunctionPointer handler(object, member);
+        schedule(handler, us);
+    }
+
+    void detach();
+
+protected:
+    Ticker(bool oneShot);
+
+    void init();
+    void schedule(const FunctionPointer& handler, unsigned int us);
+    static void* run(void* ticker);
+
+    bool _oneShot;
+    bool _quit;
+    bool _started;
+    unsigned int _generation;
+    uint64_t _interval;     // us
+    uint64_t _next;         // us
+    FunctionPointer _handler;
+    pthread_t _thread;
+    pthread_mutex_t _mutex;
+    pthread_cond_t _changed;
+};
+
+/** Calls a function once after a delay */
+class Timeout : public Ticker {
+
+public:
+    Timeout() : Ticker(true) { }
+};
+
+/***************************************
+ * Serial                              *
+ ***************************************/
+
+/** Serial port backed by a file, pipe or pty
+ *
+ * The device is taken from MBED_HOST_SERIAL_<tx pin>, e.g.
+ * MBED_HOST_SERIAL_p13=/tmp/drive.fifo. USBTX writes to stdout if nothing
+ * is given, any other port without a device reads nothing and drops writes.
+ */
+class Serial {
+
+public:
+    enum IrqType {
+        RxIrq = 0,
+        TxIrq
+    };
+
+    Serial(PinName tx, PinName rx, const char* name = NULL);
+    ~Serial();
+
+    void baud(int) { }
+
+    int readable();
+
+    int writeable() {
+        return 1;
+    }
+
+    int getc();
+    int putc(int c);
+    int puts(const char* s);
+    int printf(const char* format, ...);
+
+    void attach(void (*function)(), IrqType type = RxIrq) {
+        FunctionPointer handler(function);
+        setHandler(handler, type);
+    }
+
+    template<typename T>
+    void attach(T* object, void (T::*member)(), IrqType type = RxIrq) {
+        FunctionPointer handler(object, member);
+        setHandler(handler, type);
+    }
+
+protected:
+    void setHandler(const FunctionPointer& handler, IrqType type);
+    static void* run(void* serial);
+
+    int _fd;
+    bool _reading;
+    FunctionPointer _rxHandler;
+    unsigned char _rx[256];
+    unsigned int _rxHead;
+    unsigned int _rxTail;
+    pthread_t _thread;
+    pthread_mutex_t _mutex;
+    pthread_cond_t _received;
+};
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/* Host (Linux) stand-in for the soro MbedChannel, over loopback UDP.
+ *
+ * Each datagram carries exactly one message, without the handshake and
+ * headers of the real channel, so a host firmware can't talk to the real
+ * rover software. It can talk to another host firmware, or to a test script.
+ *
+ * Messages go to MBED_HOST_PEER (default 127.0.0.1:<port>), and are
+ * received on MBED_HOST_BIND (default any free port). An empty datagram
+ * stands in for a reset request: the reset listener is called and the
+ * program exits.
+ */
+
+#ifndef SORO_HOST_MBEDCHANNEL_H
+#define SORO_HOST_MBEDCHANNEL_H
+
+#include "mbed.h"
+#include "enums.h"
+#include "constants.h"
+
+#include <netinet/in.h>
+
+namespace Soro {
+
+class MbedChannel {
+
+public:
+    /** Open the channel
+     *
+     * @param mbedId ID of this mbed, one of the MBED_ID_* constants
+     * @param port UDP port of the computer this mbed talks to
+     */
+    MbedChannel(unsigned char mbedId, int port);
+    ~MbedChannel();
+
+    /** Set a function to call before resetting on request */
+    void setResetListener(void (*listener)());
+
+    /** Set how long read() waits for a message, in ms */
+    void setTimeout(unsigned int millis);
+
+    void sendMessage(char* message, int length);
+
+    /** Wait for a message
+     *
+     * @returns The length of the message, or -1 if none arrived in time
+     */
+    int read(char* outMessage, int maxLength);
+
+private:
+    unsigned char _mbedId;
+    int _socket;
+    unsigned int _timeout;
+    void (*_resetListener)();
+    sockaddr_in _peer;
+};
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* A stand-in for MbedChannel that reads datagrams a test has queued, so
+ * MessageDrain can be tested without a network or the soro headers
+ *
+ * A test target puts host/mock ahead of host in its include path, so this
+ * replaces host/mbedchannel.h. read() never waits: it returns -1 once the
+ * queue is empty, whatever the timeout. Each datagram takes
+ * MOCK_CHANNEL_SPACING to come in, so no two arrive at the same time.
+ */
+
+#ifndef SORO_HOST_MOCK_MBEDCHANNEL_H
+#define SORO_HOST_MOCK_MBEDCHANNEL_H
+
+#include "mbed.h"
+
+#include <cstring>
+
+#define MOCK_CHANNEL_DATAGRAMS 64
+#define MOCK_CHANNEL_DATAGRAM_SIZE 64
+
+// Time between datagrams coming in, in us
+#define MOCK_CHANNEL_SPACING 100
+
+namespace Soro {
+
+class MbedChannel {
+
+public:
+    MbedChannel() : _count(0), _next(0) { }
+
+    // Nothing waits, so there is no timeout to keep
+    void setTimeout(unsigned int) { }
+
+    void sendMessage(char*, int) { }
+
+    int read(char* outMessage, int maxLength) {
+        if (_next == _count) return -1;
+        wait_us(MOCK_CHANNEL_SPACING);
+        int length = _lengths[_next];
+        if (length > maxLength) length = maxLength;
+        memcpy(outMessage, _datagrams[_next++], length);
+        return length;
+    }
+
+    /** Add a datagram for read() to return, in order */
+    void queue(const char* message, int length) {
+        if ((_count == MOCK_CHANNEL_DATAGRAMS) || (length > MOCK_CHANNEL_DATAGRAM_SIZE)) return;
+        memcpy(_datagrams[_count], message, length);
+        _lengths[_count++] = length;
+    }
+
+    /** Datagrams queued and not read yet */
+    int waiting() const {
+        return _count - _next;
+    }
+
+private:
+    char _datagrams[MOCK_CHANNEL_DATAGRAMS][MOCK_CHANNEL_DATAGRAM_SIZE];
+    int _lengths[MOCK_CHANNEL_DATAGRAMS];
+    int _count;
+    int _next;
+};
+
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/* Host (Linux) stand-in for the parts of mbed-rtos the firmwares use.
+ * Threads are pthreads. Priorities are accepted but ignored, so anything
+ * measured here says nothing about priority inversion on the board.
+ */
+
+#ifndef SORO_HOST_RTOS_H
+#define SORO_HOST_RTOS_H
+
+#include "mbed.h"
+
+#define osWaitForever 0xFFFFFFFF
+#define DEFAULT_STACK_SIZE 2048
+
+typedef enum {
+    osPriorityIdle = -3,
+    osPriorityLow = -2,
+    osPriorityBelowNormal = -1,
+    osPriorityNormal = 0,
+    osPriorityAboveNormal = 1,
+    osPriorityHigh = 2,
+    osPriorityRealtime = 3
+} osPriority;
+
+typedef enum {
+    osOK = 0,
+    osEventSignal = 0x08,
+    osEventTimeout = 0x40,
+    osErrorParameter = 0x80,
+    osErrorResource = 0x81
+} osStatus;
+
+typedef struct {
+    osStatus status;
+    union {
+        uint32_t v;
+        int32_t signals;
+    } value;
+} osEvent;
+
+namespace Host {
+    struct ThreadState;
+}
+
+typedef Host::ThreadState* osThreadId;
+
+/** ID of the calling thread, including the main thread */
+osThreadId osThreadGetId();
+
+/** Set signal flags on a thread, safe to call from interrupt handlers
+ *
+ * @returns The previous signal flags
+ */
+int32_t osSignalSet(osThreadId thread, int32_t signals);
+
+class Thread {
+
+public:
+    Thread(void (*task)(void const* argument), void* argument = NULL,
+            osPriority priority = osPriorityNormal,
+            uint32_t stackSize = DEFAULT_STACK_SIZE,
+            unsigned char* stackPointer = NULL);
+    ~Thread();
+
+    /** Set signal flags on this thread
+     *
+     * @returns The previous signal flags
+     */
+    int32_t signal_set(int32_t signals);
+
+    /** Clear signal flags on this thread
+     *
+     * @returns The previous signal flags
+     */
+    int32_t signal_clr(int32_t signals);
+
+    osStatus set_priority(osPriority priority) {
+        _priority = priority;
+        return osOK;
+    }
+
+    osPriority get_priority() {
+        return _priority;
+    }
+
+    osThreadId gettid() {
+        return _state;
+    }
+
+    /** Wait for all of the given signal flags on the calling thread, or for
+     * any flag if signals is 0. The flags that ended the wait are cleared.
+     */
+    static osEvent signal_wait(int32_t signals, uint32_t millisec = osWaitForever);
+
+    static osStatus wait(uint32_t millisec);
+    static osStatus yield();
+
+private:
+    static void* run(void* thread);
+
+    void (*_task)(void const*);
+    void* _argument;
+    osPriority _priority;
+    Host::ThreadState* _state;
+    pthread_t _thread;
+};
+
+class Mutex {
+
+public:
+    Mutex();
+    ~Mutex();
+
+    osStatus lock(uint32_t millisec = osWaitForever);
+    bool trylock();
+    osStatus unlock();
+
+private:
+    pthread_mutex_t _mutex;
+};
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "DebouncedSwitch.h"
+
+DebouncedSwitch::DebouncedSwitch(PinName pin, int debounce) : _in(pin) {
+    _debounce = debounce;
+    _state = _in.read();
+    _locked = false;
+    _in.rise(this, &DebouncedSwitch::edge);
+    _in.fall(this, &DebouncedSwitch::edge);
+}
+
+void DebouncedSwitch::edge() {
+    if (_locked) return;
+    update(_in.read());
+}
+
+void DebouncedSwitch::settle() {
+    _locked = false;
+    update(_in.read());
+}
+
+/* Takes a new level, and ignores the switch for a while if it changed
+ */
+void DebouncedSwitch::update(int level) {
+    if (level == _state) return;
+    _state = level;
+    _locked = true;
+    _lockout.attach_us(this, &DebouncedSwitch::settle, _debounce);
+    _change.call();
+}
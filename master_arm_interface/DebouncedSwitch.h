@@ -0,0 +1,88 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_DEBOUNCEDSWITCH_H
+#define SORO_DEBOUNCEDSWITCH_H
+
+#include "mbed.h"
+
+// Time a switch is ignored after it changes, in us
+#define SWITCH_DEBOUNCE_US 20000
+
+/** A switch input that reports debounced changes from its interrupts
+ *
+ * The first edge is taken straight away, so a change is seen as soon as
+ * the contacts first touch. The switch is then ignored while it bounces,
+ * and read once more when that time is up in case it settled the other way.
+ *
+ * Example:
+ * @code
+ * DebouncedSwitch stowSwitch(p6);
+ *
+ * void stowChanged() {
+ *     // runs in interrupt context
+ * }
+ *
+ * int main() {
+ *     stowSwitch.change(&stowChanged);
+ *     // ...
+ * }
+ * @endcode
+ */
+class DebouncedSwitch {
+
+public:
+    /** Create a switch on a pin
+     *
+     * @param pin Pin the switch is connected to
+     * @param debounce Time the switch is ignored after it changes, in us
+     */
+    DebouncedSwitch(PinName pin, int debounce = SWITCH_DEBOUNCE_US);
+
+    /** Set a function to call, in interrupt context, when the debounced state changes */
+    void change(void (*function)()) {
+        _change.attach(function);
+    }
+
+    template<typename T>
+    void change(T* object, void (T::*member)()) {
+        _change.attach(object, member);
+    }
+
+    /** Debounced state of the switch */
+    inline int read() {
+        return _state;
+    }
+
+    inline operator int() {
+        return read();
+    }
+
+protected:
+    void edge();
+    void settle();
+    void update(int level);
+
+    InterruptIn _in;
+    Timeout _lockout;
+    FunctionPointer _change;
+    int _debounce;              // us
+    volatile int _state;
+    volatile bool _locked;
+};
+
+#endif
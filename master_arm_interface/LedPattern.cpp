@@ -0,0 +1,66 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "LedPattern.h"
+
+LedPattern::LedPattern(PinName pin) : _pwm(pin) {
+    _pwm.period_us(LED_PWM_PERIOD);
+    _steps = NULL;
+    _count = 0;
+    _level = -1;
+    output(0);
+}
+
+void LedPattern::play(const LedStep* steps, int count) {
+    __disable_irq();
+    _ticker.detach();
+    _steps = steps;
+    _count = count;
+    enter(0);
+    if ((count > 1) || steps[0].fade) {
+        _ticker.attach_us(this, &LedPattern::tick, LED_PATTERN_TICK);
+    }
+    __enable_irq();
+}
+
+void LedPattern::enter(int step) {
+    _step = step;
+    _elapsed = 0;
+    _from = _level;
+    if (!_steps[step].fade) {
+        output(_steps[step].level);
+    }
+}
+
+void LedPattern::tick() {
+    _elapsed += LED_PATTERN_TICK / 1000;
+    const LedStep& step = _steps[_step];
+    if (_elapsed >= step.duration) {
+        output(step.level);
+        enter(_step + 1 < _count ? _step + 1 : 0);
+        return;
+    }
+    if (step.fade) {
+        output(_from + (step.level - _from) * _elapsed / step.duration);
+    }
+}
+
+void LedPattern::output(int level) {
+    if (level == _level) return;
+    _level = level;
+    _pwm.pulsewidth_us(level * LED_PWM_PERIOD / 255);
+}
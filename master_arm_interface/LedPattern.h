@@ -0,0 +1,83 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_LEDPATTERN_H
+#define SORO_LEDPATTERN_H
+
+#include "mbed.h"
+
+// Pattern steps advance on a ticker at this period, in us
+#define LED_PATTERN_TICK 10000
+
+// PWM period of the LED, in us
+#define LED_PWM_PERIOD 1000
+
+/** One step of an LED pattern */
+struct LedStep {
+    unsigned char level;        // brightness 0-255 at the end of the step
+    bool fade;                  // ramp from the previous level instead of jumping
+    unsigned short duration;    // ms
+};
+
+/** Plays looping brightness patterns on a PWM LED in the background
+ *
+ * A ticker walks through the steps of the pattern and only touches the PWM
+ * when the brightness changes. A pattern with a single steady step writes
+ * once and stops the ticker, so holding a level costs nothing.
+ *
+ * Example:
+ * @code
+ * const LedStep blink[] = {
+ *     {255, false, 100},
+ *     {0, false, 100}
+ * };
+ * LedPattern led(p26);
+ *
+ * int main() {
+ *     led.play(blink, 2);
+ *     // ...
+ * }
+ * @endcode
+ */
+class LedPattern {
+
+public:
+    LedPattern(PinName pin);
+
+    /** Start looping a pattern, replacing whatever was playing
+     *
+     * @param steps Steps of the pattern, which must stay valid while it plays
+     * @param count Number of steps
+     */
+    void play(const LedStep* steps, int count);
+
+protected:
+    void tick();
+    void enter(int step);
+    void output(int level);
+
+    PwmOut _pwm;
+    Ticker _ticker;
+    const LedStep* _steps;
+    int _count;
+    int _step;
+    int _elapsed;               // ms into the current step
+    int _from;                  // level at the start of the current step
+    int _level;
+};
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PotSampler.h"
+
+#if defined(TARGET_LPC1768)
+
+// ADC clock = PCLK / (CLKDIV + 1) must be 13MHz or less, PCLK is CCLK / 4
+#define ADC_CLKDIV 1
+
+#define ADCR_BURST (1 << 16)
+#define ADCR_PDN (1 << 21)
+
+/* Finds the ADC channel (0-5) on a pin, or -1 if it isn't an analog pin
+ */
+static int adcChannel(PinName pin) {
+    switch (pin) {
+    case P0_23: return 0;
+    case P0_24: return 1;
+    case P0_25: return 2;
+    case P0_26: return 3;
+    case P1_30: return 4;
+    case P1_31: return 5;
+    default: return -1;
+    }
+}
+
+#endif
+
+PotSampler::PotSampler(int sampleRate, int oversampleBits, int filterShift) {
+    _samplePeriod = 1000000 / sampleRate;
+    _oversampleBits = oversampleBits < 0 ? 0 : (oversampleBits > 4 ? 4 : oversampleBits);
+    _filterShift = filterShift;
+    _count = 0;
+    _samples = 0;
+    _primed = false;
+}
+
+int PotSampler::add(PinName pin) {
+    if (_count >= POT_SAMPLER_MAX_CHANNELS) return -1;
+#if defined(TARGET_LPC1768)
+    int channel = adcChannel(pin);
+    if (channel < 0) return -1;
+    _channel[_count] = channel;
+#endif
+    // Sets up the pin function and powers the ADC
+    _inputs[_count] = new AnalogIn(pin);
+    _sum[_count] = 0;
+    _state[_count] = 0;
+    _value[_count] = 0;
+    return _count++;
+}
+
+void PotSampler::start() {
+#if defined(TARGET_LPC1768)
+    uint32_t select = 0;
+    for (int i = 0; i < _count; i++) {
+        select |= 1 << _channel[i];
+    }
+    // Interrupts stay off, the ticker reads the data registers directly
+    LPC_ADC->ADINTEN = 0;
+    LPC_ADC->ADCR = select | (ADC_CLKDIV << 8) | ADCR_BURST | ADCR_PDN;
+#endif
+    _ticker.attach_us(this, &PotSampler::sample, _samplePeriod);
+}
+
+/* Latest 12 bit result of a channel
+ */
+unsigned int PotSampler::read12(int index) {
+#if defined(TARGET_LPC1768)
+    return ((&LPC_ADC->ADDR0)[_channel[index]] >> 4) & 0xFFF;
+#else
+    return _inputs[index]->read_u16() >> 4;
+#endif
+}
+
+void PotSampler::sample() {
+    for (int i = 0; i < _count; i++) {
+        _sum[i] += read12(i);
+    }
+    if (++_samples < (1 << _oversampleBits)) return;
+    _samples = 0;
+    
+    for (int i = 0; i < _count; i++) {
+        // Scale the sum to 16 bits, stretching 0-65520 to 0-65535
+        unsigned int average = _sum[i] << (4 - _oversampleBits);
+        average += average >> 12;
+        _sum[i] = 0;
+        if (_primed) {
+            int error = (int)(average << 8) - (int)_state[i];
+            _state[i] += error >> _filterShift;
+        }
+        else {
+            // Start from the first average instead of rising from 0
+            _state[i] = average << 8;
+        }
+        _value[i] = (unsigned short)((_state[i] + 128) >> 8);
+    }
+    _primed = true;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SORO_POTSAMPLER_H
+#define SORO_POTSAMPLER_H
+
+#include "mbed.h"
+
+#define POT_SAMPLER_MAX_CHANNELS 6
+
+/** Samples potentiometers in the background and filters them
+ *
+ * On the LPC1768 the ADC is put in burst mode, where it scans the channels
+ * by itself and keeps the latest result of each in its data registers. A
+ * ticker picks those results up, so no interrupt handler or caller ever
+ * waits on a conversion. Every 2^oversampleBits samples are averaged, and
+ * the averages go through a first order integer IIR filter.
+ *
+ * Once start() is called nothing else may use the ADC, including the
+ * AnalogIn objects on the same pins.
+ *
+ * Example:
+ * @code
+ * PotSampler pots(2000, 3, 2);    // 250 filtered values per second
+ *
+ * int main() {
+ *     int yaw = pots.add(p15);
+ *     pots.start();
+ *     while (1) {
+ *         unsigned short position = pots.read_u16(yaw);
+ *         // ...
+ *     }
+ * }
+ * @endcode
+ */
+class PotSampler {
+
+public:
+    /** Create a sampler with no channels
+     *
+     * @param sampleRate Samples per second of each channel
+     * @param oversampleBits Average 2^oversampleBits samples per output, 0-4
+     * @param filterShift IIR filter strength, each output moves 1/2^filterShift of the way to the new average
+     */
+    PotSampler(int sampleRate, int oversampleBits, int filterShift);
+
+    /** Add an analog input pin
+     *
+     * @returns Index of the channel, or -1 if it can't be sampled
+     */
+    int add(PinName pin);
+
+    /** Start sampling all added channels */
+    void start();
+
+    /** Latest filtered value of a channel
+     *
+     * @param returns A number 0-65535 representing the full range.
+     */
+    inline unsigned short read_u16(int index) {
+        return _value[index];
+    }
+
+protected:
+    void sample();
+    unsigned int read12(int index);
+
+    Ticker _ticker;
+    int _samplePeriod;          // us
+    int _oversampleBits;
+    int _filterShift;
+    int _count;
+    int _samples;
+    bool _primed;
+#if defined(TARGET_LPC1768)
+    int _channel[POT_SAMPLER_MAX_CHANNELS];
+#endif
+    AnalogIn* _inputs[POT_SAMPLER_MAX_CHANNELS];
+    unsigned int _sum[POT_SAMPLER_MAX_CHANNELS];
+    unsigned int _state[POT_SAMPLER_MAX_CHANNELS];  // filter state, Q8 of the 16 bit value
+    volatile unsigned short _value[POT_SAMPLER_MAX_CHANNELS];
+};
+
+#endif
@@ -20,23 +20,62 @@
 #include "armmessage.h"
 #include "mbedchannel.h"
 
-#include <climits>
+#include "PotSampler.h"
+#include "DebouncedSwitch.h"
+#include "LedPattern.h"
+#include "PeriodicTask.h"
+#include "DiagnosticMessage.h"
+#include "LatencyTrace.h"
 
-#define READ_INTERVAL 50
+// Rate of the read and send loop, which also caps the packet rate
+#define CONTROL_RATE 250
+
+// A packet is sent as soon as a joint moves more than SEND_DEADBAND (out of
+// 65535) or a switch changes. While nothing changes, a heartbeat is sent
+// every SEND_HEARTBEAT ms so the arm's 500ms channel timeout never expires.
+#define SEND_HEARTBEAT 150
+#define SEND_DEADBAND 64
+
+// Set to 1 to append a sequence number and timestamp to every packet, so
+// the arm can count lost packets and play them out evenly. Whatever relays
+// the packets to the arm has to pass the trailer and the MBED_MESSAGE_TRACED
+// type bit through.
+#define SEND_TRACE 0
+
+// The pots are sampled at 2kHz and every 8 samples are averaged, so new
+// values come out at 250Hz. Each one moves the output a quarter of the way.
+#define POT_SAMPLE_RATE 2000
+#define POT_OVERSAMPLE_BITS 3
+#define POT_FILTER_SHIFT 2
 
 using namespace Soro;
  
-AnalogIn yaw(p15);
-AnalogIn shoulder(p16);
-AnalogIn elbow(p17);
-AnalogIn wrist(p18);
+enum Pot {
+    Pot_Yaw = 0,
+    Pot_Shoulder,
+    Pot_Elbow,
+    Pot_Wrist,
+    Pot_Count
+};
+
+// Everything a master arm packet carries
+struct MasterState {
+    unsigned short pots[Pot_Count];
+    bool bucket;
+    bool stow;
+    bool dump;
+};
+
+PotSampler pots(POT_SAMPLE_RATE, POT_OVERSAMPLE_BITS, POT_FILTER_SHIFT);
+PeriodicTask controlTask(1000000 / CONTROL_RATE);
 
-InterruptIn bucketSwitch(p5);
-InterruptIn deploySwitch(p6);
-InterruptIn dumpSwitch(p7);
-InterruptIn onSwitch(p8);
+DebouncedSwitch bucketSwitch(p5);
+DebouncedSwitch deploySwitch(p6);
+DebouncedSwitch dumpSwitch(p7);
+DebouncedSwitch onSwitch(p8);
+volatile bool switchesChanged = false;
 
-PwmOut statusLed(p26);
+LedPattern statusLed(p26);
 
 MbedChannel *ethernet;
 
@@ -48,96 +87,188 @@ enum State {
     IllegalState
 };
 
+// Status LED pattern for each State
+const LedStep connectingPattern[] = {
+    {255, false, 50}, {0, false, 50},
+    {255, false, 50}, {0, false, 50},
+    {255, false, 50}, {0, false, 50},
+    {255, false, 50}, {0, false, 50},
+    {255, false, 50}, {0, false, 3050}
+};
+const LedStep offPattern[] = {
+    {0, false, 1000}
+};
+const LedStep stowPattern[] = {
+    {255, true, 1000},
+    {0, true, 1000}
+};
+const LedStep onPattern[] = {
+    {255, false, 1000}
+};
+const LedStep illegalPattern[] = {
+    {255, false, 100},
+    {0, false, 100}
+};
+
 State currentState;
 char buffer[50];
 
-void ledLoop(void const *args) {
-    while (1) {
-        switch (currentState) {
-        case ConnectingState:
-            for (int i = 0; i < 5; i++) {
-                statusLed = 1;
-                wait(0.05);
-                statusLed = 0;
-                wait(0.05);
-            }
-            wait(3);
-            break;
-        case OffState:
-            statusLed = 0;
-            break;
-        case StowState:
-            for(float p = 0.0f; p <= 1.0f; p += 0.01f) {
-                statusLed = p;
-                wait(0.01);
-            }
-            if (currentState != StowState) continue;
-            for(float p = 1.0f; p >= 0.0f; p -= 0.01f) {
-                statusLed = p;
-                wait(0.01);
-            }
-            break;
-        case OnState:
-            statusLed = 1;
-            break;
-        case IllegalState:
-            statusLed = 1;
-            wait(0.1);
-            statusLed = 0;
-            wait(0.1);
-            break;
+MasterState lastSent;
+bool sentOnce = false;
+unsigned short sendSequence = 0;
+Timer sendTimer;
+
+/* Checks if a state is different enough from the last one sent to be
+ * worth a packet
+ */
+bool changedSinceSend(const MasterState& state) {
+    if ((state.bucket != lastSent.bucket) || (state.stow != lastSent.stow) || (state.dump != lastSent.dump)) {
+        return true;
+    }
+    for (int i = 0; i < Pot_Count; i++) {
+        int delta = state.pots[i] - lastSent.pots[i];
+        if ((delta > SEND_DEADBAND) || (delta < -SEND_DEADBAND)) {
+            return true;
         }
     }
+    return false;
 }
 
+/* Reads the master arm, and sends it if it moved or the heartbeat is due
+ */
 void readAndSend(bool overrideDeploySwitch, bool overrideDeployValue) {
-    unsigned short shoulderVal, yawVal, elbowVal, wristVal;
-    yawVal = yaw.read() * USHRT_MAX;
-    shoulderVal = shoulder.read() * USHRT_MAX;
-    elbowVal = elbow.read() * USHRT_MAX;
-    wristVal = wrist.read() * USHRT_MAX;
+    MasterState state;
+    for (int i = 0; i < Pot_Count; i++) {
+        state.pots[i] = pots.read_u16(i);
+    }
+    state.bucket = bucketSwitch;
+    state.stow = overrideDeploySwitch ? !overrideDeployValue : !deploySwitch;
+    state.dump = dumpSwitch;
+    
+    if (sentOnce && (sendTimer.read_ms() < SEND_HEARTBEAT) && !changedSinceSend(state)) {
+        return;
+    }
+    
     ArmMessage::setMasterArmData(&buffer[0], 
-            yawVal, 
-            shoulderVal, 
-            elbowVal, 
-            wristVal, 
-            bucketSwitch, 
-            (overrideDeploySwitch ? !overrideDeployValue : !deploySwitch), 
-            dumpSwitch);
-    ethernet->sendMessage(&buffer[0], ArmMessage::RequiredSize_Master);
+            state.pots[Pot_Yaw], 
+            state.pots[Pot_Shoulder], 
+            state.pots[Pot_Elbow], 
+            state.pots[Pot_Wrist], 
+            state.bucket, 
+            state.stow, 
+            state.dump);
+    int length = ArmMessage::RequiredSize_Master;
+#if SEND_TRACE
+    length = LatencyTrace::append(&buffer[0], length, sendSequence++, us_ticker_read());
+#endif
+    ethernet->sendMessage(&buffer[0], length);
+    lastSent = state;
+    sentOnce = true;
+    sendTimer.reset();
+}
+
+/* Switch interrupts land here once debounced
+ */
+void switchChanged() {
+    switchesChanged = true;
+    controlTask.notify();
+}
+
+/* Changes state, and the LED pattern with it
+ */
+void setState(State state) {
+    if (state == currentState) return;
+    currentState = state;
+    switch (state) {
+    case ConnectingState:
+        statusLed.play(connectingPattern, sizeof(connectingPattern) / sizeof(LedStep));
+        break;
+    case OffState:
+        statusLed.play(offPattern, sizeof(offPattern) / sizeof(LedStep));
+        break;
+    case StowState:
+        statusLed.play(stowPattern, sizeof(stowPattern) / sizeof(LedStep));
+        break;
+    case OnState:
+        statusLed.play(onPattern, sizeof(onPattern) / sizeof(LedStep));
+        break;
+    case IllegalState:
+        statusLed.play(illegalPattern, sizeof(illegalPattern) / sizeof(LedStep));
+        break;
+    }
+}
+
+/* Works out the state from the switches
+ */
+void updateState() {
+    if (!onSwitch) {
+        setState(OffState);
+    }
+    else if ((currentState == IllegalState) ? dumpSwitch : (!deploySwitch && dumpSwitch)) {
+        // stowed while the dump switch is on, do not
+        // let the arm deploy until dump switch is turned off
+        setState(IllegalState);
+    }
+    else {
+        setState(deploySwitch ? OnState : StowState);
+    }
+}
+
+/* Answers any diagnostic requests, without waiting for one
+ */
+void serviceRequests() {
+    char request[50];
+    int len;
+    while ((len = ethernet->read(&request[0], sizeof(request))) > 0) {
+        switch ((unsigned char)request[0]) {
+        case MBED_MESSAGE_TIMING_REQUEST: {
+            char report[DiagnosticMessage::RequiredSize_TimingReport];
+            int length = DiagnosticMessage::setTimingReport(&report[0], controlTask.overruns(),
+                    controlTask.jitter(), controlTask.execution());
+            ethernet->sendMessage(&report[0], length);
+            controlTask.resetStats();
+            break;
+        }
+        case MBED_MESSAGE_ECHO:
+            ethernet->sendMessage(&request[0], len);
+            break;
+        }
+    }
 }
 
 int main() {
-    currentState = ConnectingState;
-    Thread ledThread(ledLoop);
+    currentState = OffState;
+    setState(ConnectingState);
+    
+    // Added in the order of enum Pot
+    pots.add(p15);
+    pots.add(p16);
+    pots.add(p17);
+    pots.add(p18);
+    pots.start();
     
     ethernet = new MbedChannel(MBED_ID_MASTER_ARM, NETWORK_MC_MASTER_ARM_PORT);
-
+    ethernet->setTimeout(0);
+    sendTimer.start();
+    
+    // A switch change wakes the loop straight away, so it goes out
+    // without waiting for the next release
+    bucketSwitch.change(&switchChanged);
+    deploySwitch.change(&switchChanged);
+    dumpSwitch.change(&switchChanged);
+    onSwitch.change(&switchChanged);
+    updateState();
+    
+    controlTask.start();
     while(1) {
-        if (onSwitch) {
-            if (!deploySwitch) {
-                if (dumpSwitch) {
-                    // stowed while the dump switch is on, do not
-                    // let the arm deploy until dump switch is turned off
-                    currentState = IllegalState;
-                    while (dumpSwitch & onSwitch) { 
-                        readAndSend(true, false);
-                        wait_ms(READ_INTERVAL);
-                    }
-                    if (!onSwitch) continue;
-                }
-                else {
-                    currentState = StowState;
-                }
-            }
-            else {
-                currentState = OnState;
-            }
-            readAndSend(false, false);
-            wait_ms(READ_INTERVAL);
+        controlTask.wait();
+        if (switchesChanged) {
+            switchesChanged = false;
+            updateState();
         }
-        else {
-            currentState = OffState;
+        if (currentState != OffState) {
+            readAndSend(currentState == IllegalState, false);
         }
+        serviceRequests();
     }
 }
@@ -15,30 +15,129 @@
  */
  
 #include "mbed.h"
+#include "rtos.h"
 #include "Serial.h"
 #include "mbedchannel.h"
 #include "enums.h"
 #include "constants.h"
 #include "drivemessage.h"
 #include "Servo.h"
+#include "ServoGroup.h"
+#include "SlewLimiter.h"
+#include "TwistMessage.h"
+#include "TwistMixer.h"
+#include "SerialForwarder.h"
+#include "DriveSerialParser.h"
+#include "LatencyTrace.h"
+#include "DiagnosticMessage.h"
+#include "MessageDrain.h"
+#include "JitterBuffer.h"
+#include "PeriodicTask.h"
+#include "RingBuffer.h"
 
 #include <cstdio>
+#include <climits>
 
 Servo Drive_LeftOuter(p21);
 Servo Drive_LeftMiddle(p23);
 Servo Drive_RightOuter(p22);
 Servo Drive_RightMiddle(p24);
 
+// Written together so all wheels start moving in the same PWM period
+ServoGroup _driveGroup;
+
+// Wheels ramp towards the commanded speeds this many times a second
+#define DRIVE_RAMP_RATE 500
+
+// Time for a wheel to go from stopped to full speed, in ms
+#define DRIVE_ACCEL_TIME 400
+
+// Time for a failsafe stop to bring a wheel from full speed to stopped, in ms
+#define DRIVE_STOP_TIME 150
+
+// Commands only set targets, the ramp owns _driveGroup and writes the wheels
+SlewLimiter _driveRamp(_driveGroup, DRIVE_RAMP_RATE, DRIVE_ACCEL_TIME, DRIVE_STOP_TIME);
+
+// Twist commands are remixed into wheel speeds every actuation cycle
+TwistMixer _mixer;
+bool _twistActive = false;
+
+// Rate the actuation thread checks the failsafe at, in Hz. Commands are
+// applied as soon as they are queued rather than waiting for the next cycle.
+#define DRIVE_CONTROL_RATE 100
+
+// Drive stops if no ethernet drive command arrives for this long, in ms
+#define DRIVE_TIMEOUT 500
+
+// Longest traced commands are held to even out bursty delivery, in us.
+// 0 applies every command as soon as it arrives.
+#define COMMAND_JITTER_DEPTH 40000
+
+// Serial drive commands override ethernet drive for this long, in ms
+#define DRIVE_SERIAL_OVERRIDE 1000
+
+// How often the serial thread checks for data and forwards it, in ms
+#define SERIAL_POLL_INTERVAL 2
+
+// Commands held between an I/O thread and the actuation thread
+#define COMMAND_QUEUE_SIZE 8
+
+// Compress the sensor records sent on, 0 to send them as they arrive
+#define DATA_COMPRESSION 1
+
+/* A message handed from an I/O thread to the actuation thread
+ */
+struct Command {
+    int length;
+    uint32_t receivedAt;
+    char message[MESSAGE_DRAIN_MESSAGE_SIZE];
+};
+
 Timer _driveEthernetTimer;
 Timer _driveSerialTimer;
+bool _serialOverride = false;
+// The ethernet thread feeds it and sends its report, the actuation thread
+// adds the latency samples, so the samples and report go through the lock
+LatencyTrace _latency;
+Mutex _latencyLock;
+
+// Plays traced commands out at the rate they were sent. Only the ethernet
+// thread touches it, the report included.
+JitterBuffer _jitter(COMMAND_JITTER_DEPTH);
+
+// Each queue has one I/O thread pushing and the actuation thread popping
+RingBuffer<Command, COMMAND_QUEUE_SIZE> _ethernetCommands;
+RingBuffer<Command, COMMAND_QUEUE_SIZE> _serialCommands;
+PeriodicTask _actuation(1000000 / DRIVE_CONTROL_RATE);
+
+// Set by the channel's reset listener, which runs on the ethernet thread
+volatile bool _channelReset = false;
+
+// Both the serial and actuation threads send, so sends are serialized
+Mutex _sendLock;
+
+DigitalOut led1(LED1);
+DigitalOut led2(LED2);
+DigitalOut led3(LED3);
 
 using namespace Soro;
 
+MbedChannel* _ethernet;
+SerialForwarder* _dataForwarder;
+DriveSerialParser* _driveParser;
+
 void stopDrive() {
-    Drive_LeftOuter.write(0.5);
-    Drive_LeftMiddle.write(0.5);
-    Drive_RightOuter.write(0.5);
-    Drive_RightMiddle.write(0.5);
+    _twistActive = false;
+    _driveRamp.halt();
+}
+
+/* Converts a wheel speed from -1 to 1 into a servo position,
+ * in single precision so it doesn't pull in the double math library
+ */
+inline unsigned short wheelPosition(float speed) {
+    if (speed <= -1.0f) return 0;
+    if (speed >= 1.0f) return USHRT_MAX;
+    return (unsigned short)((speed + 1.0f) * 32767.5f + 0.5f);
 }
 
 void setDrive(const char* buffer) {
@@ -47,24 +146,183 @@ void setDrive(const char* buffer) {
     float ml = DriveMessage::getLeftMiddle(buffer);
     float mr = -DriveMessage::getRightMiddle(buffer);
     
-    Drive_LeftOuter.write(((float)lo)/2.0 + 0.5);
-    Drive_RightOuter.write(((float)ro)/2.0 + 0.5);
-    Drive_LeftMiddle.write(((float)ml)/2.0 + 0.5);
-    Drive_RightMiddle.write(((float)mr)/2.0 + 0.5);
+    _driveRamp.setTarget(Drive_LeftOuter, wheelPosition(lo));
+    _driveRamp.setTarget(Drive_RightOuter, wheelPosition(ro));
+    _driveRamp.setTarget(Drive_LeftMiddle, wheelPosition(ml));
+    _driveRamp.setTarget(Drive_RightMiddle, wheelPosition(mr));
+}
+
+/* Mixes the last twist into wheel speeds. The right side is
+ * mirrored, as it is in setDrive().
+ */
+void applyTwist() {
+    int speeds[TwistMixer::WheelCount];
+    _mixer.mix(speeds);
+    
+    _driveRamp.setTarget(Drive_LeftOuter, SLEW_LIMITER_CENTER + speeds[TwistMixer::LeftOuter]);
+    _driveRamp.setTarget(Drive_LeftMiddle, SLEW_LIMITER_CENTER + speeds[TwistMixer::LeftMiddle]);
+    _driveRamp.setTarget(Drive_RightOuter, SLEW_LIMITER_CENTER - speeds[TwistMixer::RightOuter]);
+    _driveRamp.setTarget(Drive_RightMiddle, SLEW_LIMITER_CENTER - speeds[TwistMixer::RightMiddle]);
 }
 
 /* Listener which receives the ethernet's disconnected
  * event (which triggers a reset). The rover should stop
- * if this is the case.
+ * if this is the case, so the wheels are stopped here before
+ * the channel resets, and the actuation thread clears the rest.
  */
 void preResetListener() {
-    stopDrive();
+    _driveRamp.stop();
+    _channelReset = true;
+    _actuation.notify();
+}
+
+void sendMessage(char* message, int length) {
+    _sendLock.lock();
+    _ethernet->sendMessage(message, length);
+    _sendLock.unlock();
 }
 
-int main() {    
+/* Answers latency and jitter report requests on the ethernet thread, which
+ * is the one feeding both
+ *
+ * @returns false if the message isn't one of them
+ */
+bool sendReport(const Command& command) {
+    unsigned int header = (unsigned char)command.message[0];
+    switch (header) {
+    case MBED_MESSAGE_LATENCY_REQUEST: {
+        char report[DiagnosticMessage::RequiredSize_LatencyReport];
+        _latencyLock.lock();
+        int length = DiagnosticMessage::setLatencyReport(&report[0], _latency);
+        _latency.reset();
+        _latencyLock.unlock();
+        sendMessage(&report[0], length);
+        return true;
+    }
+    case MBED_MESSAGE_JITTER_REQUEST: {
+        char report[DiagnosticMessage::RequiredSize_JitterReport];
+        sendMessage(&report[0], DiagnosticMessage::setJitterReport(&report[0], _jitter));
+        _jitter.reset();
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+/* Ethernet RX thread. Blocks on the channel, which is the only thing
+ * allowed to block, and queues everything it reads apart from report
+ * requests, which it answers itself.
+ */
+void ethernetLoop(void const*) {
+    // Only the newest command of a backlog is queued
+    MessageDrain messages(*_ethernet, _latency, DRIVE_TIMEOUT);
+    messages.setJitterBuffer(&_jitter);
+    Command command;
+    // A command that didn't fit in the queue, pushed again once there is room
+    Command held;
+    bool holding = false;
+    
+    while (1) {
+        command.length = messages.read(&command.message[0], &command.receivedAt);
+        if (holding && _ethernetCommands.push(held)) {
+            holding = false;
+        }
+        if ((command.length == -1) || sendReport(command)) continue;
+        
+        // A full queue means actuation is stuck. Rather than dropping this
+        // command, it replaces the held one, so actuation ends up with the
+        // newest command when it catches up.
+        if (holding || !_ethernetCommands.push(command)) {
+            held = command;
+            holding = true;
+        }
+        _actuation.notify();
+    }
+}
+
+/* Serial ingest thread. Forwards loggable data and queues serial
+ * drive commands. Both serial ports are read in the background
+ * by interrupts, so this only has to poll.
+ */
+void serialLoop(void const*) {
+    Command command;
+    command.length = DRIVE_SERIAL_FRAME_SIZE;
+    // A frame that didn't fit in the queue, pushed again once there is room
+    Command held;
+    bool holding = false;
+    
+    while (1) {
+        _sendLock.lock();
+        led1 = _dataForwarder->poll();
+        _sendLock.unlock();
+        
+        if (holding && _serialCommands.push(held)) {
+            holding = false;
+        }
+        if (_driveParser->read(&command.message[0])) {
+            command.receivedAt = us_ticker_read();
+            // As on ethernet, the newest frame replaces the held one
+            if (holding || !_serialCommands.push(command)) {
+                held = command;
+                holding = true;
+            }
+            _actuation.notify();
+        }
+        Thread::wait(SERIAL_POLL_INTERVAL);
+    }
+}
+
+/* Adds a latency sample for a command that has reached the wheels
+ */
+void actuated(const Command& command) {
+    _latencyLock.lock();
+    _latency.actuated(command.receivedAt);
+    _latencyLock.unlock();
+}
+
+/* Applies one message from the ethernet queue
+ */
+void handleEthernetCommand(Command& command) {
+    char* buffer = &command.message[0];
+    
+    unsigned int header = (unsigned int)reinterpret_cast<unsigned char&>(buffer[0]);
+    switch (header) {
+    case MbedMessage_Drive:
+        // Serial drive overrides ethernet drive
+        if (_serialOverride) break;
+        _twistActive = false;
+        setDrive(buffer);
+        actuated(command);
+        _driveEthernetTimer.reset();
+        break;
+    case MBED_MESSAGE_TWIST:
+        if (_serialOverride || (command.length < TwistMessage::RequiredSize)) break;
+        _mixer.setTwist(TwistMessage::getLinear(buffer), TwistMessage::getAngular(buffer),
+                TwistMessage::getCurvature(buffer, command.length));
+        _twistActive = true;
+        applyTwist();
+        actuated(command);
+        _driveEthernetTimer.reset();
+        break;
+    case MBED_MESSAGE_ECHO:
+        sendMessage(buffer, command.length);
+        break;
+    default:
+        break; 
+    }
+}
+
+int main() {
+    _driveGroup.add(Drive_LeftOuter);
+    _driveGroup.add(Drive_LeftMiddle);
+    _driveGroup.add(Drive_RightOuter);
+    _driveGroup.add(Drive_RightMiddle);
+    _driveRamp.start();
+    
     MbedChannel ethernet(MBED_ID_RESEARCH, NETWORK_ROVER_RESEARCH_MBED_PORT);
     ethernet.setResetListener(&preResetListener);
-    ethernet.setTimeout(500); // drive will stop if this timeout is reached
+    _ethernet = &ethernet;
     
     Serial driveSerial(p13, p14);
     Serial dataSerial(p9, p10);
@@ -73,82 +331,65 @@ int main() {
     driveSerial.baud(9600);
     dataSerial.baud(9600);
     
-    char buffer[500];
-    int bufferOffset;
-    
-    DigitalOut led1(LED1);
-    DigitalOut led2(LED2);
-    DigitalOut led3(LED3);
-    DigitalOut led4(LED4);
+    // Loggable data is buffered in the background and sent in batches
+    SerialForwarder dataForwarder(dataSerial, ethernet);
+    dataForwarder.setCompression(DATA_COMPRESSION);
+    _dataForwarder = &dataForwarder;
+    // Serial drive commands are decoded in the background as well
+    DriveSerialParser driveParser(driveSerial);
+    _driveParser = &driveParser;
     
     _driveEthernetTimer.start();
     
+    // main is the actuation thread, the I/O threads run below it
+    Thread ethernetThread(ethernetLoop, NULL, osPriorityBelowNormal);
+    Thread serialThread(serialLoop, NULL, osPriorityBelowNormal);
+    
+    Command command;
+    bool stopped = false;
+    _actuation.start();
+    
     while(1) {
-        bufferOffset = 0;
-        // Process any loggable data first
-        while (dataSerial.readable()) {
-            buffer[bufferOffset] = dataSerial.getc();
-            bufferOffset++;
-        }
-        if (bufferOffset > 0) {
-            led1 = 1;
-            ethernet.sendMessage(buffer, bufferOffset);
-        }
-        else {
-            led1 = 0;
-        }
+        _actuation.wait();
         
-        // See if there is a message waiting on the drive serial port
-        while (driveSerial.readable()) {
-            _driveSerialTimer.start();
+        // Apply the newest serial command, if any
+        bool serialDrive = false;
+        while (_serialCommands.pop(command)) {
+            serialDrive = true;
+        }
+        if (serialDrive) {
             _driveSerialTimer.reset();
-            int c = driveSerial.getc();
-            if (c != 255) continue;
-            
-            for (int i = 1; i < 5; i++) {
-                buffer[i] = driveSerial.getc();
-                if (buffer[i] > 200) {
-                    buffer[i] = 100;
-                }
-            }
-            //pc.printf("Got complete drive command: %u %u %u %u\r\n", buffer[1], buffer[2], buffer[3], buffer[4]);
-            
+            _driveSerialTimer.start();
             led2 = 1;
             led3 = 0;
-            setDrive(buffer);
+            _twistActive = false;
+            setDrive(&command.message[0]);
+            _serialOverride = true;
+            stopped = false;
         }
         
-        int dst = _driveSerialTimer.read_us(); //MICRO second
-        if ((dst > 0) && (dst < 1000000)) { // Serial drive overrides ethernet drive for 1 second
-            continue;
+        while (_ethernetCommands.pop(command)) {
+            handleEthernetCommand(command);
+        }
+        
+        if (_serialOverride) {
+            if (_driveSerialTimer.read_ms() < DRIVE_SERIAL_OVERRIDE) continue;
+            _serialOverride = false;
+            _driveSerialTimer.stop();
         }
-        _driveSerialTimer.stop();
-        _driveSerialTimer.reset();
         
         // No serial drive control, fallback to ethernet control
         led2 = 0;
         led3 = 1;
-        //wait_ms(100);
-        //continue;
-        
-        int len = ethernet.read(&buffer[0], 50);
-        if (len == -1) {
-            stopDrive();
-            continue;
-        }
         
-        unsigned int header = (unsigned int)reinterpret_cast<unsigned char&>(buffer[0]);
-        MbedMessageType messageType = reinterpret_cast<MbedMessageType&>(header);
-        switch (messageType) {
-        case MbedMessage_Drive:
-            setDrive(buffer);            
-            _driveEthernetTimer.reset();
-            break;
-        default:
-            break; 
+        if (_channelReset || (_driveEthernetTimer.read_ms() > DRIVE_TIMEOUT)) {
+            _channelReset = false;
+            if (!stopped) stopDrive();
+            stopped = true;
         }
-        if (_driveEthernetTimer.read_ms() > 500) {
-            stopDrive();
+        else {
+            stopped = false;
+            if (_twistActive) applyTwist();
         }
     }
 }
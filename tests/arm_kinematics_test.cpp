@@ -0,0 +1,191 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Checks the fixed point ArmKinematics against a double precision solve
+ * over the whole workspace, and against the float calcAngles() it replaced
+ */
+
+#include "ArmKinematics.h"
+#include "ArmLimits.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// Worst joint angle error allowed, in hundredths of a degree
+#define ANGLE_TOLERANCE 5
+// Worst wrist position error allowed after solve() then forward(), in mm
+#define POSITION_TOLERANCE 2
+#define TRIG_SAMPLES 100000
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        return 1; \
+    } \
+} while (0)
+
+static double degrees(double radians) {
+    return radians * 180.0 / M_PI;
+}
+
+/* The same law of cosines solve as the firmware, in double precision and
+ * in hundredths of a degree
+ */
+static void referenceSolve(int x, int y, double wristOffset,
+        double& shoulder, double& elbow, double& wrist) {
+    double bicep = BICEP_LENGTH;
+    double forearm = FOREARM_LENGTH;
+    double lengthSquared = (double)x * x + (double)y * y;
+    double length = sqrt(lengthSquared);
+    
+    double direction = atan2((double)y, (double)x);
+    double lift = acos((lengthSquared + bicep * bicep - forearm * forearm) / (2 * length * bicep));
+    double inside = acos((bicep * bicep + forearm * forearm - lengthSquared) / (2 * bicep * forearm));
+    
+    shoulder = degrees(direction + lift) * 100;
+    elbow = degrees(inside) * 100;
+    wrist = degrees((M_PI - lift - inside) + (M_PI / 2 - direction)) * 100 + wristOffset;
+}
+
+/* calcAngles() from before ArmKinematics, minus the servo writes
+ */
+static void floatSolve(int x, int y, float& shoulder, float& elbow) {
+    float lengthOne = BICEP_LENGTH;
+    float lengthTwo = FOREARM_LENGTH;
+    float lengthSq = (x * x) + (y * y);
+    float length = sqrtf(lengthSq);
+    float phiOne = (y < 0 ? -1 : 1) * acosf(x / length);
+    float phiTwo = acosf(((length * length) + (lengthOne * lengthOne) - (lengthTwo * lengthTwo)) / (2 * length * lengthOne));
+    shoulder = (phiOne + phiTwo) * (float)(18000.0 / M_PI);
+    elbow = acosf(((lengthOne * lengthOne) + (lengthTwo * lengthTwo) - lengthSq) / (2 * lengthOne * lengthTwo))
+            * (float)(18000.0 / M_PI);
+}
+
+static double error(int angle, double reference) {
+    return fabs(angle - reference);
+}
+
+static int checkTrig() {
+    double worstAtan = 0, worstSin = 0;
+    srand(1);
+    for (int i = 0; i < TRIG_SAMPLES; i++) {
+        int y = rand() % 131071 - 65535;
+        int x = rand() % 131071 - 65535;
+        if ((x == 0) && (y == 0)) continue;
+        double e = error(ArmKinematics::atan2(y, x), degrees(atan2((double)y, (double)x)) * 100);
+        if (e > worstAtan) worstAtan = e;
+        
+        int angle = rand() % 72001 - 36000;
+        double radians = angle * M_PI / 18000;
+        e = fabs(ArmKinematics::sin(angle) - sin(radians) * 32767);
+        if (e > worstSin) worstSin = e;
+        e = fabs(ArmKinematics::cos(angle) - cos(radians) * 32767);
+        if (e > worstSin) worstSin = e;
+    }
+    printf("atan2 worst error %.2f hundredths of a degree\n", worstAtan);
+    printf("sin/cos worst error %.2f Q15 counts\n", worstSin);
+    CHECK(worstAtan <= 2);
+    CHECK(worstSin <= 4);
+    
+    for (uint32_t value = 0; value < 1000000; value += 7) {
+        uint32_t root = ArmKinematics::sqrt(value);
+        CHECK(root * root <= value);
+        CHECK((root + 1) * (root + 1) > value);
+    }
+    CHECK(ArmKinematics::sqrt(0xFFFFFFFFUL) == 65535);
+    return 0;
+}
+
+static int checkSolve() {
+    const int reach = BICEP_LENGTH + FOREARM_LENGTH;
+    double worst = 0, worstFloat = 0;
+    int worstPosition = 0;
+    int checked = 0;
+    for (int x = -reach; x <= reach; x++) {
+        for (int y = -reach; y <= reach; y++) {
+            // Only targets solve() would be given, clampWorkspace() leaves them alone
+            int cx = x, cy = y;
+            if (ArmKinematics::clampWorkspace(cx, cy)) continue;
+            int wristOffset = (x * 7 + y * 13) % 9001 - 4500;
+            
+            ArmAngles angles;
+            ArmKinematics::solve(x, y, wristOffset, angles);
+            double shoulder, elbow, wrist;
+            referenceSolve(x, y, wristOffset, shoulder, elbow, wrist);
+            
+            double e = error(angles.shoulder, shoulder);
+            if (error(angles.elbow, elbow) > e) e = error(angles.elbow, elbow);
+            if (error(angles.wrist, wrist) > e) e = error(angles.wrist, wrist);
+            if (e > worst) worst = e;
+            if (e > ANGLE_TOLERANCE) {
+                printf("solve(%d, %d) gave %d %d %d, expected %.1f %.1f %.1f\n", x, y,
+                        angles.shoulder, angles.elbow, angles.wrist, shoulder, elbow, wrist);
+                return 1;
+            }
+            
+            float floatShoulder, floatElbow;
+            floatSolve(x, y, floatShoulder, floatElbow);
+            e = fabs(floatShoulder - shoulder);
+            if (fabs(floatElbow - elbow) > e) e = fabs(floatElbow - elbow);
+            if (e > worstFloat) worstFloat = e;
+            
+            int fx, fy;
+            ArmKinematics::forward(angles, fx, fy);
+            int distance = abs(fx - x) > abs(fy - y) ? abs(fx - x) : abs(fy - y);
+            if (distance > worstPosition) worstPosition = distance;
+            if (distance > POSITION_TOLERANCE) {
+                printf("forward(solve(%d, %d)) gave (%d, %d)\n", x, y, fx, fy);
+                return 1;
+            }
+            checked++;
+        }
+    }
+    printf("%d targets, worst joint error %.2f hundredths of a degree (float %.2f)\n",
+            checked, worst, worstFloat);
+    printf("worst round trip error %d mm\n", worstPosition);
+    CHECK(checked > 0);
+    return 0;
+}
+
+static int checkClamp() {
+    const int maxReach = BICEP_LENGTH + FOREARM_LENGTH;
+    for (int x = -2 * maxReach; x <= 2 * maxReach; x += 3) {
+        for (int y = -2 * maxReach; y <= 2 * maxReach; y += 3) {
+            int cx = x, cy = y;
+            ArmKinematics::clampWorkspace(cx, cy);
+            double length = sqrt((double)cx * cx + (double)cy * cy);
+            CHECK(length <= maxReach);
+            // A clamped target must still be reachable, or solve() can't get there
+            ArmAngles angles;
+            ArmKinematics::solve(cx, cy, 0, angles);
+            int fx, fy;
+            ArmKinematics::forward(angles, fx, fy);
+            CHECK(abs(fx - cx) <= POSITION_TOLERANCE);
+            CHECK(abs(fy - cy) <= POSITION_TOLERANCE);
+        }
+    }
+    return 0;
+}
+
+int main() {
+    if (checkTrig()) return 1;
+    if (checkSolve()) return 1;
+    if (checkClamp()) return 1;
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Round trips blocks through Cobs::encode() and Cobs::decode(), around the
+ * edges of the encoding: empty blocks, zeros at either end and in a row,
+ * and runs of non-zero bytes either side of the 254 a code byte can hold
+ */
+
+#include "Cobs.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define MAX_BLOCK 1100
+#define RANDOM_BLOCKS 20000
+
+static int _failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            _failures++; \
+        } \
+    } while (0)
+
+/* Encodes and decodes a block, checking the encoding has no zeros, fits
+ * in maxEncodedSize() and gives back the block
+ *
+ * @returns The encoded length
+ */
+static int roundTrip(const char* block, int length) {
+    char encoded[MAX_BLOCK + MAX_BLOCK / 254 + 2];
+    char decoded[sizeof(encoded)];
+    int encodedLength = Cobs::encode(block, length, encoded);
+    CHECK(encodedLength <= Cobs::maxEncodedSize(length));
+    CHECK(memchr(encoded, 0, encodedLength) == NULL);
+    
+    int decodedLength = Cobs::decode(encoded, encodedLength, decoded);
+    CHECK(decodedLength == length);
+    if (decodedLength == length) {
+        CHECK(memcmp(decoded, block, length) == 0);
+    }
+    return encodedLength;
+}
+
+static void fill(char* block, int length, char value) {
+    memset(block, value, length);
+}
+
+static void testEmpty() {
+    char encoded[1];
+    char decoded[1];
+    CHECK(Cobs::encode(NULL, 0, encoded) == 1);
+    CHECK(encoded[0] == 1);
+    CHECK(Cobs::decode(encoded, 1, decoded) == 0);
+    CHECK(Cobs::decode(encoded, 0, decoded) == 0);
+}
+
+static void testZeros() {
+    char block[8];
+    
+    // Only zeros, each one becomes a code byte of 1
+    for (int length = 1; length <= 8; length++) {
+        fill(block, length, 0);
+        CHECK(roundTrip(block, length) == length + 1);
+    }
+    
+    // At the start, the end and in a row in the middle
+    const char mixed[] = { 0, 'a', 'b', 0, 0, 'c', 0 };
+    CHECK(roundTrip(mixed, sizeof(mixed)) == (int)sizeof(mixed) + 1);
+    
+    const char known[] = { 0x11, 0x22, 0x00, 0x33 };
+    char encoded[8];
+    CHECK(Cobs::encode(known, sizeof(known), encoded) == 5);
+    CHECK(memcmp(encoded, "\x03\x11\x22\x02\x33", 5) == 0);
+}
+
+static void testLongRuns() {
+    char block[MAX_BLOCK];
+    
+    // A full run of 254 closes its code byte with 0xFF, which decodes
+    // without adding a zero after it
+    for (int length = 252; length <= 258; length++) {
+        fill(block, length, 'x');
+        roundTrip(block, length);
+        
+        // The same run with a zero after it, and before it
+        block[length] = 0;
+        roundTrip(block, length + 1);
+        block[0] = 0;
+        fill(&block[1], length, 'x');
+        roundTrip(block, length + 1);
+    }
+    
+    char encoded[MAX_BLOCK + 8];
+    fill(block, 254, 'x');
+    int length = Cobs::encode(block, 254, encoded);
+    CHECK((unsigned char)encoded[0] == 0xFF);
+    CHECK(length == 256);
+    
+    fill(block, 255, 'x');
+    length = Cobs::encode(block, 255, encoded);
+    CHECK((unsigned char)encoded[0] == 0xFF);
+    CHECK(encoded[255] == 2);
+    CHECK(length == 257);
+    
+    // Several full runs back to back, as long a block as the forwarder sends
+    fill(block, MAX_BLOCK, 'x');
+    roundTrip(block, MAX_BLOCK);
+}
+
+static void testRandom() {
+    char block[MAX_BLOCK];
+    for (int i = 0; i < RANDOM_BLOCKS; i++) {
+        int length = rand() % (MAX_BLOCK + 1);
+        // From mostly zeros to none at all
+        int zeros = rand() % 4;
+        for (int j = 0; j < length; j++) {
+            block[j] = ((zeros > 0) && (rand() % (1 << (zeros * 3)) == 0)) ? 0 : (char)(1 + rand() % 255);
+        }
+        roundTrip(block, length);
+    }
+}
+
+static void testMalformed() {
+    char decoded[8];
+    // A zero never appears in an encoded block
+    CHECK(Cobs::decode("\x02\x11\x00", 3, decoded) == -1);
+    CHECK(Cobs::decode("\x00", 1, decoded) == -1);
+    // A code byte running past the end
+    CHECK(Cobs::decode("\x05\x11\x22", 3, decoded) == -1);
+    CHECK(Cobs::decode("\x02\x11\x03\x22", 4, decoded) == -1);
+}
+
+int main() {
+    srand(1);
+    testEmpty();
+    testZeros();
+    testLongRuns();
+    testRandom();
+    testMalformed();
+    
+    if (_failures) {
+        printf("%d checks failed\n", _failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Checks CollisionMap::pathClear() against a brute force walk: any segment
+ * that passes through a blocked cell at any point along it must be rejected
+ */
+
+#include "CollisionMap.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#define SEGMENTS 20000
+#define SAMPLES 4000
+
+static int cellOf(const CollisionAxis& axis, double position) {
+    if (position <= axis.min) return 0;
+    if (position > axis.max) position = axis.max;
+    return (int)(((uint32_t)(position - axis.min) * axis.scale) >> 16);
+}
+
+static bool blockedAt(double yaw, double shoulder, double elbow) {
+    int y = cellOf(_collisionYawAxis, yaw);
+    int s = cellOf(_collisionShoulderAxis, shoulder);
+    int e = cellOf(_collisionElbowAxis, elbow);
+    return (_collisionMap[y][s] >> e) & 1;
+}
+
+/* Somewhere in an axis' range. setPositions() clamps to the joint limits
+ * before checking a path, so that's all pathClear() ever sees.
+ */
+static unsigned short randomPosition(const CollisionAxis& axis) {
+    return (unsigned short)(axis.min + rand() % (axis.max - axis.min + 1));
+}
+
+int main() {
+    srand(1);
+    int failures = 0;
+    int rejected = 0;
+    for (int i = 0; i < SEGMENTS; i++) {
+        CollisionPose from = {
+            randomPosition(_collisionYawAxis),
+            randomPosition(_collisionShoulderAxis),
+            randomPosition(_collisionElbowAxis)
+        };
+        CollisionPose to = {
+            randomPosition(_collisionYawAxis),
+            randomPosition(_collisionShoulderAxis),
+            randomPosition(_collisionElbowAxis)
+        };
+        
+        // Sample the segment at whole positions, skipping the starting cell
+        // like pathClear() does
+        bool hit = false;
+        for (int sample = 1; (sample <= SAMPLES) && !hit; sample++) {
+            double t = (double)sample / SAMPLES;
+            int yaw = (int)(from.yaw + (to.yaw - from.yaw) * t + 0.5);
+            int shoulder = (int)(from.shoulder + (to.shoulder - from.shoulder) * t + 0.5);
+            int elbow = (int)(from.elbow + (to.elbow - from.elbow) * t + 0.5);
+            if ((cellOf(_collisionYawAxis, yaw) == cellOf(_collisionYawAxis, from.yaw))
+                    && (cellOf(_collisionShoulderAxis, shoulder) == cellOf(_collisionShoulderAxis, from.shoulder))
+                    && (cellOf(_collisionElbowAxis, elbow) == cellOf(_collisionElbowAxis, from.elbow))) {
+                continue;
+            }
+            hit = blockedAt(yaw, shoulder, elbow);
+        }
+        
+        bool clear = CollisionMap::pathClear(from, to);
+        if (hit && clear) {
+            printf("missed a collision from (%u, %u, %u) to (%u, %u, %u)\n",
+                    from.yaw, from.shoulder, from.elbow, to.yaw, to.shoulder, to.elbow);
+            failures++;
+        }
+        if (!clear) rejected++;
+    }
+    
+    printf("%d of %d segments rejected\n", rejected, SEGMENTS);
+    if (failures) {
+        printf("%d collisions missed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Checks JitterBuffer's playout order and counters, the zero depth bypass,
+ * timestamps wrapping and a sender clock restart. Every time is passed in,
+ * so none of this depends on the host clock.
+ */
+
+#include "JitterBuffer.h"
+
+#include <cstdio>
+
+static int _failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            _failures++; \
+        } \
+    } while (0)
+
+/* Pushes a command of a type, carrying its timestamp so pop() can be
+ * checked against it
+ */
+static void push(JitterBuffer& jitter, char type, uint32_t timestamp, uint32_t arrival) {
+    char message[5] = {
+        type,
+        (char)(timestamp & 0xFF),
+        (char)((timestamp >> 8) & 0xFF),
+        (char)((timestamp >> 16) & 0xFF),
+        (char)(timestamp >> 24)
+    };
+    jitter.push(&message[0], sizeof(message), timestamp, arrival);
+}
+
+/* Pops a command and checks it is the one expected
+ */
+static void expect(JitterBuffer& jitter, uint32_t now, char type, uint32_t timestamp, uint32_t arrival) {
+    char buffer[JITTER_BUFFER_MESSAGE_SIZE];
+    uint32_t popped = 0;
+    int length = jitter.pop(&buffer[0], now, &popped);
+    CHECK(length == 5);
+    if (length != 5) return;
+    uint32_t sent = (unsigned char)buffer[1] | ((unsigned char)buffer[2] << 8)
+            | ((unsigned char)buffer[3] << 16) | ((uint32_t)(unsigned char)buffer[4] << 24);
+    CHECK(buffer[0] == type);
+    CHECK(sent == timestamp);
+    CHECK(popped == arrival);
+}
+
+static bool empty(JitterBuffer& jitter, uint32_t now) {
+    char buffer[JITTER_BUFFER_MESSAGE_SIZE];
+    return jitter.pop(&buffer[0], now) == -1;
+}
+
+static void testOrder() {
+    JitterBuffer jitter(40000);
+    push(jitter, 1, 0, 1000);
+    push(jitter, 2, 20000, 21000);
+    // Sent between the two, but arriving with the second and past its playout time
+    push(jitter, 3, 10000, 21000);
+    CHECK(jitter.reordered() == 1);
+    CHECK(jitter.late() == 1);
+    CHECK(jitter.depth() > 0);
+    
+    // Nothing is due before its sender time plus the transit time
+    CHECK(empty(jitter, 500));
+    expect(jitter, 21000, 1, 0, 1000);
+    expect(jitter, 21000, 3, 10000, 21000);
+    CHECK(empty(jitter, 21000));
+    CHECK(jitter.wait(21000) > 0);
+    expect(jitter, 21000 + jitter.wait(21000), 2, 20000, 21000);
+    CHECK(jitter.wait(21000) == -1);
+    CHECK(jitter.dropped() == 0);
+}
+
+static void testDropped() {
+    JitterBuffer jitter(40000);
+    push(jitter, 1, 0, 1000);
+    expect(jitter, 100000, 1, 0, 1000);
+    
+    // Older than what has been played out already
+    push(jitter, 2, 0, 2000);
+    CHECK(jitter.dropped() == 1);
+    CHECK(empty(jitter, 100000));
+    
+    // A repeated copy
+    push(jitter, 2, 5000, 6000);
+    push(jitter, 2, 5000, 6500);
+    CHECK(jitter.dropped() == 2);
+    
+    // Another of the same type due at the same time replaces it
+    push(jitter, 2, 6000, 7000);
+    expect(jitter, 100000, 2, 6000, 7000);
+    CHECK(jitter.dropped() == 3);
+    CHECK(empty(jitter, 100000));
+    
+    // A full buffer drops the oldest
+    for (int i = 0; i < JITTER_BUFFER_SLOTS + 1; i++) {
+        push(jitter, (char)(10 + i), 10000 + i * 100, 11000 + i * 100);
+    }
+    CHECK(jitter.dropped() == 4);
+    expect(jitter, 100000, 11, 10100, 11100);
+    
+    jitter.reset();
+    CHECK(jitter.dropped() == 0);
+    CHECK(jitter.late() == 0);
+    CHECK(jitter.reordered() == 0);
+}
+
+static void testBypass() {
+    // Turned off, everything is due at once whatever its timestamp
+    JitterBuffer jitter(0);
+    CHECK(!jitter.enabled());
+    push(jitter, 1, 1000000, 5000);
+    CHECK(jitter.wait(0) == 0);
+    expect(jitter, 0, 1, 1000000, 5000);
+    CHECK(jitter.depth() == 0);
+    
+    // Turning it off plays out anything held
+    JitterBuffer held(40000);
+    push(held, 1, 0, 1000);
+    push(held, 2, 50000, 51000);
+    held.setMaxDepth(0);
+    expect(held, 0, 1, 0, 1000);
+    expect(held, 0, 2, 50000, 51000);
+}
+
+static void testWrap() {
+    // Timestamps and arrivals both wrapping past zero
+    JitterBuffer jitter(40000);
+    push(jitter, 1, 0xFFFFF000, 0xFFFFFF00);
+    push(jitter, 2, 0x00000F00, 0x00001E00);
+    push(jitter, 3, 0xFFFFF800, 0x00002000);
+    CHECK(jitter.reordered() == 1);
+    CHECK(jitter.resyncs() == 0);
+    expect(jitter, 0x00100000, 1, 0xFFFFF000, 0xFFFFFF00);
+    expect(jitter, 0x00100000, 3, 0xFFFFF800, 0x00002000);
+    expect(jitter, 0x00100000, 2, 0x00000F00, 0x00001E00);
+}
+
+static void testRestart() {
+    JitterBuffer jitter(40000);
+    uint32_t now = 5000000;
+    for (int i = 0; i < 50; i++) {
+        push(jitter, (char)(1 + i % 2), 600000 + i * 10000, now + i * 10000);
+    }
+    expect(jitter, now + 500000, 1, 600000 + 48 * 10000, now + 48 * 10000);
+    CHECK(jitter.resyncs() == 0);
+    
+    // The sender restarts with its clock back near zero. Without the resync
+    // everything from it would be dropped as older than what was played.
+    now += 500000;
+    push(jitter, 3, 200, now);
+    CHECK(jitter.resyncs() == 1);
+    expect(jitter, now + 100000, 3, 200, now);
+    push(jitter, 3, 10200, now + 10000);
+    expect(jitter, now + 100000, 3, 10200, now + 10000);
+    CHECK(jitter.resyncs() == 1);
+    
+    // So does one whose clock jumped forward, a transit time far off the mean
+    push(jitter, 4, 10200 + 2 * JITTER_BUFFER_RESYNC, now + 20000);
+    CHECK(jitter.resyncs() == 2);
+    expect(jitter, now + 100000, 4, 10200 + 2 * JITTER_BUFFER_RESYNC, now + 20000);
+}
+
+int main() {
+    testOrder();
+    testDropped();
+    testBypass();
+    testWrap();
+    testRestart();
+    
+    if (_failures) {
+        printf("%d checks failed\n", _failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Checks MessageDrain and LatencyTrace against the queued datagrams of the
+ * mock channel in host/mock: only the newest message of each type is kept,
+ * each keeps its own arrival time, stale traced copies are dropped, and a
+ * sequence that restarts is picked up again rather than dropped
+ */
+
+#include "MessageDrain.h"
+
+#include <cstdio>
+
+static int _failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            _failures++; \
+        } \
+    } while (0)
+
+#define TYPE_A 0x01
+#define TYPE_B 0x02
+
+static void queue(Soro::MbedChannel& channel, char type, char value) {
+    char message[2] = { type, value };
+    channel.queue(&message[0], sizeof(message));
+}
+
+static void queueTraced(Soro::MbedChannel& channel, char type, char value, unsigned short sequence) {
+    char message[2 + LATENCY_TRACE_SIZE] = { type, value };
+    channel.queue(&message[0], LatencyTrace::append(&message[0], 2, sequence, sequence * 1000));
+}
+
+/* Reads a message and checks it is the one expected
+ */
+static void expect(MessageDrain& messages, char type, char value, uint32_t* receivedAt = NULL) {
+    char buffer[MESSAGE_DRAIN_MESSAGE_SIZE];
+    int length = messages.read(&buffer[0], receivedAt);
+    CHECK(length == 2);
+    CHECK(buffer[0] == type);
+    CHECK(buffer[1] == value);
+}
+
+static bool empty(MessageDrain& messages) {
+    char buffer[MESSAGE_DRAIN_MESSAGE_SIZE];
+    return messages.read(&buffer[0]) == -1;
+}
+
+static void testNewestPerType() {
+    Soro::MbedChannel channel;
+    LatencyTrace trace;
+    MessageDrain messages(channel, trace, 0);
+    queue(channel, TYPE_A, 1);
+    queue(channel, TYPE_B, 2);
+    queue(channel, TYPE_A, 3);
+    
+    // The replacement goes after B, it arrived later
+    uint32_t first, second;
+    expect(messages, TYPE_B, 2, &first);
+    CHECK(channel.waiting() == 0);
+    expect(messages, TYPE_A, 3, &second);
+    CHECK(empty(messages));
+    CHECK(messages.dropped() == 1);
+    
+    // Each message comes with its own arrival, not the last one drained
+    CHECK(first != trace.receivedAt());
+    CHECK(second == trace.receivedAt());
+    CHECK((int32_t)(second - first) >= MOCK_CHANNEL_SPACING);
+}
+
+static void testStale() {
+    Soro::MbedChannel channel;
+    LatencyTrace trace;
+    MessageDrain messages(channel, trace, 0);
+    queueTraced(channel, TYPE_A, 1, 5);
+    queueTraced(channel, TYPE_B, 2, 4);
+    expect(messages, TYPE_A, 1);
+    CHECK(empty(messages));
+    CHECK(messages.dropped() == 1);
+    
+    // A repeated copy in a later batch
+    queueTraced(channel, TYPE_A, 1, 5);
+    CHECK(empty(messages));
+    CHECK(messages.dropped() == 2);
+    
+    // Untraced messages can't be stale
+    queue(channel, TYPE_B, 3);
+    expect(messages, TYPE_B, 3);
+    
+    queueTraced(channel, TYPE_A, 4, 7);
+    expect(messages, TYPE_A, 4);
+    CHECK(trace.traced() == 2);
+    CHECK(trace.lost() == 1);
+    CHECK(trace.sequence() == 7);
+}
+
+static void testRestart() {
+    Soro::MbedChannel channel;
+    LatencyTrace trace;
+    MessageDrain messages(channel, trace, 0);
+    queueTraced(channel, TYPE_A, 1, 1000);
+    expect(messages, TYPE_A, 1);
+    
+    // Just inside the window is a late copy
+    queueTraced(channel, TYPE_A, 2, 1000 - LATENCY_TRACE_STALE_WINDOW + 1);
+    CHECK(empty(messages));
+    CHECK(trace.stale());
+    
+    // Further back, the sender has restarted, and nothing counts as lost
+    queueTraced(channel, TYPE_A, 3, 1000 - LATENCY_TRACE_STALE_WINDOW);
+    expect(messages, TYPE_A, 3);
+    CHECK(!trace.stale());
+    CHECK(trace.sequence() == 1000 - LATENCY_TRACE_STALE_WINDOW);
+    CHECK(trace.lost() == 0);
+    
+    queueTraced(channel, TYPE_A, 4, 0);
+    expect(messages, TYPE_A, 4);
+    queueTraced(channel, TYPE_A, 5, 1);
+    queueTraced(channel, TYPE_B, 6, 3);
+    expect(messages, TYPE_A, 5);
+    expect(messages, TYPE_B, 6);
+    CHECK(trace.lost() == 1);
+    CHECK(trace.traced() == 5);
+    
+    // After a reset the next message starts the sequence again
+    trace.reset();
+    queueTraced(channel, TYPE_A, 7, 200);
+    expect(messages, TYPE_A, 7);
+    CHECK(trace.lost() == 0);
+    CHECK(trace.traced() == 1);
+    queueTraced(channel, TYPE_A, 8, 190);
+    CHECK(empty(messages));
+}
+
+int main() {
+    testNewestPerType();
+    testStale();
+    testRestart();
+    
+    if (_failures) {
+        printf("%d checks failed\n", _failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Checks that ServoGroup::commit() writes each staged match register once
+ * and then latches them all with a single LER write, against the mock PWM1
+ * registers in host/MockPwm1.h
+ */
+
+#include "ServoGroup.h"
+
+#include <cstdio>
+
+static int _failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            _failures++; \
+        } \
+    } while (0)
+
+// PWM1 channels of p21-p26 are 6 down to 1
+#define CHANNEL(pin) (p26 - (pin) + 1)
+#define TICKS_PER_US (SystemCoreClock / 4000000)
+
+Servo _yaw(p21, false);
+Servo _shoulder(p22, false);
+Servo _elbow(p23, false);
+Servo _wrist(p24, false);
+Servo _bucket(p25, false);
+Servo _notPwm1(p5, false);
+
+static const MockRegister* latch() {
+    return &LPC_PWM1->LER;
+}
+
+/* Checks a logged write is to a member's match register with its pulsewidth
+ */
+static void checkMatch(int write, Servo& servo, PinName pin, unsigned short value) {
+    CHECK(MockPwm1::write(write).reg == MockPwm1::match(CHANNEL(pin)));
+    // Servo's default calibration is 1000-2000 us over the full range
+    unsigned int pulse = 1000 + ((value + (value >> 15)) * 1000u >> 16);
+    CHECK(MockPwm1::write(write).value == pulse * TICKS_PER_US);
+    CHECK(servo.read_u16() == value);
+}
+
+static void testAdd(ServoGroup& group) {
+    CHECK(group.add(_yaw) == 0);
+    CHECK(group.add(_shoulder) == 1);
+    CHECK(group.add(_elbow) == 2);
+    CHECK(group.add(_wrist) == 3);
+    CHECK(group.add(_bucket) == 4);
+    CHECK(group.add(_notPwm1) == -1);
+    CHECK(group.count() == 5);
+}
+
+static void testCommitAll(ServoGroup& group) {
+    MockPwm1::reset();
+    group.stage_u16(_yaw, 1000);
+    group.stage_u16(_shoulder, 20000);
+    group.stage_u16(_elbow, 30000);
+    group.stage_u16(_wrist, 40000);
+    group.stage_u16(_bucket, 65535);
+    
+    // Nothing reaches the registers until commit()
+    CHECK(MockPwm1::count() == 0);
+    CHECK(_yaw.read_u16() != 1000);
+    
+    group.commit();
+    CHECK(MockPwm1::count() == 6);
+    if (MockPwm1::count() != 6) return;
+    checkMatch(0, _yaw, p21, 1000);
+    checkMatch(1, _shoulder, p22, 20000);
+    checkMatch(2, _elbow, p23, 30000);
+    checkMatch(3, _wrist, p24, 40000);
+    checkMatch(4, _bucket, p25, 65535);
+    
+    // One latch, after every match register, covering all of them
+    CHECK(MockPwm1::write(5).reg == latch());
+    uint32_t bits = (1 << CHANNEL(p21)) | (1 << CHANNEL(p22)) | (1 << CHANNEL(p23))
+            | (1 << CHANNEL(p24)) | (1 << CHANNEL(p25));
+    CHECK((MockPwm1::write(5).value & bits) == bits);
+}
+
+static void testCommitSome(ServoGroup& group) {
+    // The hardware clears LER once the new values are latched
+    _mockPwm1.LER = 0;
+    MockPwm1::reset();
+    
+    group.stage_u16(_elbow, 100);
+    group.stage_u16(_elbow, 50000);     // only the last staged value is written
+    group.stage(_bucket, 0.5f);
+    group.commit();
+    CHECK(MockPwm1::count() == 3);
+    if (MockPwm1::count() != 3) return;
+    checkMatch(0, _elbow, p23, 50000);
+    checkMatch(1, _bucket, p25, 32768);
+    CHECK(MockPwm1::write(2).reg == latch());
+    CHECK(MockPwm1::write(2).value == (uint32_t)((1 << CHANNEL(p23)) | (1 << CHANNEL(p25))));
+    
+    // Members that weren't staged keep their positions
+    CHECK(_yaw.read_u16() == 1000);
+}
+
+static void testCommitNothing(ServoGroup& group) {
+    MockPwm1::reset();
+    group.commit();
+    CHECK(MockPwm1::count() == 0);
+    
+    // Out of range members are ignored
+    group.stage_u16(5, 1234);
+    group.stage_u16(-1, 1234);
+    group.stage_u16(_notPwm1, 1234);
+    group.commit();
+    CHECK(MockPwm1::count() == 0);
+}
+
+int main() {
+    ServoGroup group;
+    testAdd(group);
+    testCommitAll(group);
+    testCommitSome(group);
+    testCommitNothing(group);
+    
+    if (_failures) {
+        printf("%d checks failed\n", _failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
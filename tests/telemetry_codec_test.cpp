@@ -0,0 +1,183 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Round trips random records through TelemetryEncoder and TelemetryDecoder,
+ * resetting both every so often like SerialForwarder does for a key
+ * datagram, and feeds the decoder garbage to make sure it never overruns
+ */
+
+#include "TelemetryCodec.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define RECORDS 200000
+#define GARBAGE 50000
+
+// Longest record SerialForwarder hands over
+#define RECORD_SIZE 128
+
+// Records between resets, about what a second of 100 Hz telemetry is
+#define KEY_INTERVAL 100
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        return 1; \
+    } \
+} while (0)
+
+static const char* _labels[] = {
+    "temp=", ",hum=", ",pres=", " ", ";", "ch", ":", ",",
+    "a_rather_long_label_name=", "t", "gps lat ", " lon "
+};
+#define LABELS (sizeof(_labels) / sizeof(_labels[0]))
+
+// Values of the fields in the sensor-like records, which drift slowly
+static long _values[24];
+
+static int put(char* record, int length, const char* text) {
+    int n = (int)strlen(text);
+    if (length + n > RECORD_SIZE) n = RECORD_SIZE - length;
+    memcpy(&record[length], text, n);
+    return length + n;
+}
+
+/* Labels and slowly changing numbers, the case the codec is built for,
+ * with leading zeros, decimals and numbers too long to fit in one field
+ */
+static int sensorRecord(char* record, int shape) {
+    int length = 0;
+    int fields = 1 + shape % 20;
+    for (int i = 0; (i < fields) && (length < RECORD_SIZE); i++) {
+        length = put(record, length, _labels[(shape + i) % LABELS]);
+        
+        long& value = _values[i];
+        switch (rand() % 16) {
+        case 0:
+            value = rand();
+            break;
+        case 1:
+            value = 0;
+            break;
+        default:
+            value += rand() % 21 - 10;
+            if (value < 0) value = -value;
+            break;
+        }
+        char number[32];
+        switch (rand() % 8) {
+        case 0:
+            sprintf(number, "%05ld", value % 100000);
+            break;
+        case 1:
+            sprintf(number, "%ld.%02d", value / 100, (int)(value % 100));
+            break;
+        case 2:
+            sprintf(number, "%ld%ld", value, (long)rand());
+            break;
+        default:
+            sprintf(number, "%ld", value);
+            break;
+        }
+        length = put(record, length, number);
+    }
+    return length;
+}
+
+/* Any bytes but zero, which ends a record on the wire
+ */
+static int randomRecord(char* record) {
+    int length = rand() % (RECORD_SIZE + 1);
+    bool digits = rand() % 2;
+    for (int i = 0; i < length; i++) {
+        if (digits && (rand() % 2)) {
+            record[i] = '0' + rand() % 10;
+        }
+        else {
+            record[i] = (char)(1 + rand() % 255);
+        }
+    }
+    return length;
+}
+
+static int roundTrip() {
+    TelemetryEncoder encoder;
+    TelemetryDecoder decoder;
+    char record[RECORD_SIZE];
+    char encoded[TELEMETRY_MAX_ENCODED_SIZE(RECORD_SIZE)];
+    char decoded[RECORD_SIZE];
+    long recordBytes = 0, encodedBytes = 0;
+    int shape = 0;
+    
+    for (int i = 0; i < RECORDS; i++) {
+        if (i % KEY_INTERVAL == 0) {
+            encoder.reset();
+            decoder.reset();
+            shape = rand();
+        }
+        int length;
+        if (rand() % 8 == 0) {
+            length = randomRecord(record);
+        }
+        else {
+            length = sensorRecord(record, shape);
+        }
+        
+        int encodedLength = encoder.encode(record, length, encoded);
+        CHECK(encodedLength >= 0);
+        CHECK(encodedLength <= (int)TELEMETRY_MAX_ENCODED_SIZE(length));
+        int decodedLength = decoder.decode(encoded, encodedLength, decoded, sizeof(decoded));
+        if ((decodedLength != length) || (memcmp(decoded, record, length) != 0)) {
+            printf("record %d didn't survive: \"%.*s\"\n", i, length, record);
+            return 1;
+        }
+        recordBytes += length;
+        encodedBytes += encodedLength;
+    }
+    printf("%d records, %ld bytes encoded to %ld\n", RECORDS, recordBytes, encodedBytes);
+    return 0;
+}
+
+/* Whatever the decoder is given, it must stay inside the output buffer
+ */
+static int garbage() {
+    TelemetryDecoder decoder;
+    char in[TELEMETRY_MAX_ENCODED_SIZE(RECORD_SIZE)];
+    char out[RECORD_SIZE + 1];
+    for (int i = 0; i < GARBAGE; i++) {
+        if (i % KEY_INTERVAL == 0) decoder.reset();
+        int length = rand() % (sizeof(in) + 1);
+        for (int j = 0; j < length; j++) {
+            in[j] = (char)rand();
+        }
+        out[RECORD_SIZE] = 0x55;
+        int decoded = decoder.decode(in, length, out, RECORD_SIZE);
+        CHECK((decoded >= -1) && (decoded <= RECORD_SIZE));
+        CHECK(out[RECORD_SIZE] == 0x55);
+    }
+    return 0;
+}
+
+int main() {
+    srand(1);
+    if (roundTrip()) return 1;
+    if (garbage()) return 1;
+    return 0;
+}
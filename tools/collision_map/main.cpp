@@ -0,0 +1,109 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/* Generates arm_control/CollisionMapTable.cpp
+ *
+ * This runs on the host, not the mbed:
+ *
+ *     g++ -I arm_control -o collision_map tools/collision_map/main.cpp
+ *     ./collision_map > arm_control/CollisionMapTable.cpp
+ *
+ * Rerun it whenever the limits in ArmLimits.h or the grid size in
+ * CollisionMap.h change.
+ */
+
+#include "ArmLimits.h"
+#include "CollisionMap.h"
+
+#include <cstdio>
+
+/* The region the arm must stay out of. While the yaw is over the cage the
+ * shoulder can't go below cage height and the elbow can't fold down onto
+ * the frame. This is the model to extend as more of the rover is measured.
+ */
+static bool collides(unsigned int yaw, unsigned int shoulder, unsigned int elbow) {
+    bool overCage = (yaw > SERVO_U16(CRASH_ON_CAGE_YAW_MIN)) && (yaw < SERVO_U16(CRASH_ON_CAGE_YAW_MAX));
+    return overCage && ((shoulder > SERVO_U16(CRASH_ON_CAGE_SHOULDER)) || (elbow > SERVO_U16(CRASH_ON_FRAME_ELBOW)));
+}
+
+static CollisionAxis makeAxis(double min, double max, int cells) {
+    CollisionAxis axis;
+    axis.min = SERVO_U16(min);
+    axis.max = SERVO_U16(max);
+    axis.scale = (uint32_t)cells * 65536 / (axis.max - axis.min + 1);
+    return axis;
+}
+
+/* First and last joint positions that fall into a cell
+ */
+static void cellBounds(const CollisionAxis& axis, int cell, unsigned int& low, unsigned int& high) {
+    low = axis.max;
+    high = axis.min;
+    for (unsigned int p = axis.min; p <= axis.max; p++) {
+        if ((int)(((p - axis.min) * axis.scale) >> 16) != cell) continue;
+        if (p < low) low = p;
+        if (p > high) high = p;
+    }
+}
+
+static void printAxis(const char* name, const CollisionAxis& axis) {
+    printf("const CollisionAxis %s = { %u, %u, %u };\n", name, axis.min, axis.max, axis.scale);
+}
+
+int main() {
+    CollisionAxis yawAxis = makeAxis(MIN_YAW, MAX_YAW, COLLISION_YAW_CELLS);
+    CollisionAxis shoulderAxis = makeAxis(MIN_SHOULDER, MAX_SHOULDER, COLLISION_SHOULDER_CELLS);
+    CollisionAxis elbowAxis = makeAxis(MIN_ELBOW, MAX_ELBOW, COLLISION_ELBOW_CELLS);
+    
+    unsigned int yawLow[COLLISION_YAW_CELLS], yawHigh[COLLISION_YAW_CELLS];
+    unsigned int shoulderLow[COLLISION_SHOULDER_CELLS], shoulderHigh[COLLISION_SHOULDER_CELLS];
+    unsigned int elbowLow[COLLISION_ELBOW_CELLS], elbowHigh[COLLISION_ELBOW_CELLS];
+    for (int i = 0; i < COLLISION_YAW_CELLS; i++) cellBounds(yawAxis, i, yawLow[i], yawHigh[i]);
+    for (int i = 0; i < COLLISION_SHOULDER_CELLS; i++) cellBounds(shoulderAxis, i, shoulderLow[i], shoulderHigh[i]);
+    for (int i = 0; i < COLLISION_ELBOW_CELLS; i++) cellBounds(elbowAxis, i, elbowLow[i], elbowHigh[i]);
+    
+    printf("/* Generated by tools/collision_map from ArmLimits.h, do not edit */\n\n");
+    printf("#include \"CollisionMap.h\"\n\n");
+    printAxis("_collisionYawAxis", yawAxis);
+    printAxis("_collisionShoulderAxis", shoulderAxis);
+    printAxis("_collisionElbowAxis", elbowAxis);
+    printf("\nconst uint32_t _collisionMap[COLLISION_YAW_CELLS][COLLISION_SHOULDER_CELLS] = {\n");
+    for (int y = 0; y < COLLISION_YAW_CELLS; y++) {
+        printf("    {");
+        for (int s = 0; s < COLLISION_SHOULDER_CELLS; s++) {
+            uint32_t row = 0;
+            for (int e = 0; e < COLLISION_ELBOW_CELLS; e++) {
+                // Only mark cells that are in collision at every corner, so a
+                // pose clamped right up to a limit is never rejected
+                bool all = true;
+                for (int corner = 0; corner < 8; corner++) {
+                    unsigned int yaw = (corner & 1) ? yawHigh[y] : yawLow[y];
+                    unsigned int shoulder = (corner & 2) ? shoulderHigh[s] : shoulderLow[s];
+                    unsigned int elbow = (corner & 4) ? elbowHigh[e] : elbowLow[e];
+                    all &= collides(yaw, shoulder, elbow);
+                }
+                if (all) row |= (uint32_t)1 << e;
+            }
+            printf("%s0x%08x", (s % 8 == 0) ? (s == 0 ? " " : "\n      ") : ", ", (unsigned int)row);
+            if ((s % 8 != 7) || (s == COLLISION_SHOULDER_CELLS - 1)) continue;
+            printf(",");
+        }
+        printf(" }%s\n", y == COLLISION_YAW_CELLS - 1 ? "" : ",");
+    }
+    printf("};\n");
+    return 0;
+}
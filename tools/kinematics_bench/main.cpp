@@ -0,0 +1,127 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Compares the cost of the old float calcAngles() solve and the fixed
+ * point ArmKinematics::solve() that replaced it
+ *
+ * This runs on the host, not the mbed:
+ *
+ *     cmake --build build --target kinematics_bench
+ *     build/kinematics_bench
+ *
+ * The host has an FPU and a fast libm, so here the float path comes out
+ * ahead: the fixed point solve spends its time in 64 bit square roots and
+ * divides. The LPC1768 has no FPU, so there every sqrtf() and acosf() is a
+ * software routine too, and neither number carries over directly. Scaled
+ * by the clock ratio they still give a rough per-solve cost to hold
+ * against the 5 ms a 200 Hz jog tick allows.
+ */
+
+#include "ArmKinematics.h"
+#include "ArmLimits.h"
+
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+#define BENCH_TARGETS 4096
+#define BENCH_ROUNDS 500
+
+/* calcAngles() from before ArmKinematics, minus the servo writes
+ */
+static void floatSolve(int x, int y, float t, ArmAngles& angles) {
+    float lengthOne = BICEP_LENGTH;
+    float lengthTwo = FOREARM_LENGTH;
+    float lengthSq = (x * x) + (y * y);
+    float length = sqrtf(lengthSq);
+    float phiOne = (y < 0 ? -1 : 1) * acosf(x / length);
+    float phiTwo = acosf(((length * length) + (lengthOne * lengthOne) - (lengthTwo * lengthTwo)) / (2 * length * lengthOne));
+    float thetaOne = phiOne + phiTwo;
+    float thetaTwo = acosf(((lengthOne * lengthOne) + (lengthTwo * lengthTwo) - (lengthSq)) / (2 * lengthOne * lengthTwo));
+    float wristAngle = (PI - phiTwo - thetaTwo) + ((PI / 2) - phiOne) + t;
+    angles.shoulder = (int)(thetaOne * (float)(18000 / PI));
+    angles.elbow = (int)(thetaTwo * (float)(18000 / PI));
+    angles.wrist = (int)(wristAngle * (float)(18000 / PI));
+}
+
+static double now() {
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+static void report(const char* name, double seconds) {
+    printf("%-28s %6.1f ns per solve\n", name, seconds * 1e9 / ((double)BENCH_TARGETS * BENCH_ROUNDS));
+}
+
+int main() {
+    // A spiral through the workspace, clamped like the jog loop does
+    static int xs[BENCH_TARGETS], ys[BENCH_TARGETS];
+    for (int i = 0; i < BENCH_TARGETS; i++) {
+        double radius = (BICEP_LENGTH + FOREARM_LENGTH) * (double)i / BENCH_TARGETS;
+        double angle = i * 0.05;
+        xs[i] = (int)(radius * cos(angle));
+        ys[i] = (int)(radius * sin(angle));
+        ArmKinematics::clampWorkspace(xs[i], ys[i]);
+    }
+    
+    // Everything goes into the sink so the loops can't be optimized away
+    volatile int sink = 0;
+    int sum = 0;
+    ArmAngles angles;
+    double start = now();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_TARGETS; i++) {
+            floatSolve(xs[i], ys[i], 0, angles);
+            sum += angles.shoulder + angles.elbow + angles.wrist;
+        }
+    }
+    report("float (old calcAngles)", now() - start);
+    sink = sum;
+    
+    sum = 0;
+    start = now();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_TARGETS; i++) {
+            ArmKinematics::solve(xs[i], ys[i], 0, angles);
+            sum += angles.shoulder + angles.elbow + angles.wrist;
+        }
+    }
+    report("fixed point (solve)", now() - start);
+    sink = sum;
+    
+    // Both must agree to within the float path's truncation
+    int worst = 0;
+    for (int i = 0; i < BENCH_TARGETS; i++) {
+        ArmAngles old;
+        floatSolve(xs[i], ys[i], 0, old);
+        ArmKinematics::solve(xs[i], ys[i], 0, angles);
+        int differences[3] = {
+            angles.shoulder - old.shoulder,
+            angles.elbow - old.elbow,
+            angles.wrist - old.wrist
+        };
+        for (int j = 0; j < 3; j++) {
+            int difference = differences[j] < 0 ? -differences[j] : differences[j];
+            if (difference > worst) worst = difference;
+        }
+    }
+    printf("largest difference %d.%02d degrees\n", worst / 100, worst % 100);
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Compares the cost of working out a servo pulsewidth the old float way
+ * and the integer way Servo::write_u16() does it now
+ *
+ * This runs on the host, not the mbed, and is built with the host HAL:
+ *
+ *     cmake --build build --target servo_bench
+ *     build/servo_bench
+ *
+ * The host has an FPU, so the gap on the LPC1768, where every float and
+ * double operation is a library call, is much wider than this shows. What
+ * it does show is how much arithmetic each path does per update. The PWM
+ * write itself isn't timed, it is the same for both.
+ */
+
+#include "Servo.h"
+
+#include <cstdio>
+#include <ctime>
+
+#define BENCH_VALUES 1024
+#define BENCH_ROUNDS 20000
+
+// Pulsewidth range from center, as Servo::calibrate() defaults it
+#define BENCH_RANGE 0.0005f
+
+/* Gets at the pulsewidth calculation without writing to the PWM
+ */
+class BenchServo : public Servo {
+
+public:
+    BenchServo(PinName pin) : Servo(pin, false) { }
+
+    inline int pulse(unsigned short value) {
+        return pulsewidth(value);
+    }
+};
+
+static float clamp(float value, float min, float max) {
+    if (value < min) return min;
+    if (value > max) return max;
+    return value;
+}
+
+/* Servo::write() before the integer path, including the conversion
+ * PwmOut::pulsewidth(float) does to get to us
+ */
+static int floatPulsewidth(float percent) {
+    float offset = BENCH_RANGE * 2.0 * (percent - 0.5);
+    float seconds = 0.0015 + clamp(offset, -BENCH_RANGE, BENCH_RANGE);
+    return (int)(seconds * 1000000.0f);
+}
+
+static double now() {
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+static void report(const char* name, double seconds) {
+    printf("%-28s %6.2f ns per update\n", name, seconds * 1e9 / ((double)BENCH_VALUES * BENCH_ROUNDS));
+}
+
+int main() {
+    BenchServo servo(p21);
+    static float percents[BENCH_VALUES];
+    static unsigned short values[BENCH_VALUES];
+    for (int i = 0; i < BENCH_VALUES; i++) {
+        percents[i] = (float)i / (BENCH_VALUES - 1);
+        values[i] = (unsigned short)(percents[i] * 65535 + 0.5f);
+    }
+    
+    // Everything goes into the sink so the loops can't be optimized away
+    volatile int sink = 0;
+    int sum = 0;
+    double start = now();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_VALUES; i++) {
+            sum += floatPulsewidth(percents[i]);
+        }
+    }
+    report("float (old write)", now() - start);
+    sink = sum;
+    
+    sum = 0;
+    start = now();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_VALUES; i++) {
+            sum += servo.pulse((unsigned short)(clamp(percents[i], 0.0f, 1.0f) * 65535 + 0.5f));
+        }
+    }
+    report("float wrapper (write)", now() - start);
+    sink = sum;
+    
+    sum = 0;
+    start = now();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_VALUES; i++) {
+            sum += servo.pulse(values[i]);
+        }
+    }
+    report("integer (write_u16)", now() - start);
+    sink = sum;
+    
+    // Both paths must agree to within rounding
+    int worst = 0;
+    for (int i = 0; i < BENCH_VALUES; i++) {
+        int difference = servo.pulse(values[i]) - floatPulsewidth(percents[i]);
+        if (difference < 0) difference = -difference;
+        if (difference > worst) worst = difference;
+    }
+    printf("largest difference %d us\n", worst);
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2016 The University of Oklahoma.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/* Prints the serial records a drive or research mbed forwards
+ *
+ * This runs on the host, not the mbed. It listens for the datagrams sent by
+ * SerialForwarder, compressed or not, and prints one record per line as its
+ * timestamp in us, a tab and its bytes:
+ *
+ *     g++ -I . -o telemetry_decode tools/telemetry_decode/main.cpp TelemetryCodec.cpp
+ *     ./telemetry_decode 9002
+ *
+ * Gaps in the datagram sequence numbers and records that fail to decode are
+ * reported on stderr. It is also the reference for decoding the records on
+ * the base station.
+ */
+
+#include "Cobs.h"
+#include "TelemetryCodec.h"
+#include "SerialRecords.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#define DATAGRAM_SIZE 2048
+
+static TelemetryDecoder _decoder;
+
+/* Decodes one record of a datagram and prints it
+ *
+ * @returns false if it is malformed
+ */
+static bool printRecord(const char* encoded, int length, bool compressed, unsigned int& timestamp) {
+    char record[DATAGRAM_SIZE];
+    char text[DATAGRAM_SIZE];
+    length = Cobs::decode(encoded, length, record);
+    if (length < 0) return false;
+    
+    int header;
+    if (compressed) {
+        unsigned int delta;
+        header = TelemetryCodec::getVarint(record, length, delta);
+        if (header < 0) return false;
+        timestamp += delta;
+        length = _decoder.decode(&record[header], length - header, text, sizeof(text));
+        if (length < 0) return false;
+    }
+    else {
+        if (length < 4) return false;
+        const unsigned char* stamp = (const unsigned char*)record;
+        timestamp = stamp[0] | (stamp[1] << 8) | (stamp[2] << 16) | ((unsigned int)stamp[3] << 24);
+        length -= 4;
+        memcpy(text, &record[4], length);
+    }
+    printf("%u\t", timestamp);
+    fwrite(text, 1, length, stdout);
+    putchar('\n');
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <udp port>\n", argv[0]);
+        return 1;
+    }
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(atoi(argv[1]));
+    if (bind(sock, (sockaddr*)&address, sizeof(address)) != 0) {
+        perror("bind");
+        return 1;
+    }
+    
+    char datagram[DATAGRAM_SIZE];
+    bool synced = false;
+    bool waitForKey = true;
+    unsigned short expected = 0;
+    unsigned int timestamp = 0;
+    while (1) {
+        int length = recv(sock, datagram, sizeof(datagram), 0);
+        if (length < 3) continue;
+        unsigned char type = (unsigned char)datagram[0];
+        if ((type != MBED_MESSAGE_SERIAL_RECORDS) && (type != MBED_MESSAGE_SERIAL_RECORDS_COMPRESSED)) continue;
+        
+        unsigned short sequence = (unsigned char)datagram[1] | ((unsigned char)datagram[2] << 8);
+        if (synced && (sequence != expected)) {
+            fprintf(stderr, "lost %u datagrams\n", (unsigned short)(sequence - expected));
+            waitForKey = true;
+        }
+        synced = true;
+        expected = sequence + 1;
+        
+        // Compressed records carry on from the datagram before, unless it's a key
+        bool compressed = (type == MBED_MESSAGE_SERIAL_RECORDS_COMPRESSED);
+        int start = 3;
+        if (compressed) {
+            if (length < 4) continue;
+            if (datagram[3] & SERIAL_RECORDS_KEY) {
+                _decoder.reset();
+                timestamp = 0;
+                waitForKey = false;
+            }
+            if (waitForKey) continue;
+            start = 4;
+        }
+        
+        // Records end at zeros
+        for (int i = start; i < length; i++) {
+            if (datagram[i] != 0) continue;
+            if (!printRecord(&datagram[start], i - start, compressed, timestamp)) {
+                fprintf(stderr, "bad record in datagram %u\n", sequence);
+                waitForKey = true;
+                break;
+            }
+            start = i + 1;
+        }
+        fflush(stdout);
+    }
+}